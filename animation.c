@@ -1,29 +1,45 @@
 // animation.c
 // Control de animaciones del jugador
 // -----------------------------------
-// Carga de sprites, animación por frames,
-// actualización por delta time y dibujo con flip.
+// Clips compartidos (hoja y tabla de frames precalculada), posición de
+// cada jugador en ellos, actualización por delta time y dibujo con flip.
+// Frames, ritmo, modo y hoja de cada clip vienen de la base de
+// animaciones (animdb.c); aquí solo se piden por nombre.
 
 #include "raylib.h"
+#include "rlgl.h"
+#include <stdio.h>
 #include <stdlib.h>
 
 // ----------------------------------------------------------------------
-// ESTRUCTURA DE ANIMACIÓN
+// CLIP DE ANIMACIÓN
 // ----------------------------------------------------------------------
+// Lo que no cambia al reproducir: hoja, número de frames, ritmo, modo y, por
+// cada frame, sus coordenadas de textura (normal y volteado) y su caja
+// respecto a los pies. Se calcula una vez al cargar; todas las entidades
+// que reproducen el clip lo comparten y solo guardan su propia posición
+// (AnimCursor o los arrays animFrame/animTimer de los enemigos).
+#define ANIM_MAX_FRAMES 32
+
+// Un frame listo para dibujar: coordenadas de textura y caja
+typedef struct AnimFrame {
+    float u0, v0, u1, v1;   // Esquinas en la textura (0..1); volteado = u cambiadas
+    Rectangle quad;         // Caja relativa a los pies (centro abajo)
+} AnimFrame;
+
 typedef struct {
-    Texture2D texture;      // Sprite sheet completo
+    Sprite sheet;           // Sprite sheet completo (zona del atlas)
+    const AnimDbClip *source;   // Entrada en la base (NULL si faltaba)
     int frameCount;         // Número de frames
-    int currentFrame;       // Frame actual
-    float frameSpeed;       // Frames por segundo
-    float timer;            // Acumulador de tiempo
-    int frameWidth;         // Ancho de un frame
-    int frameHeight;        // Alto de un frame
-} Animation;
-
-// Animaciones globales
-Animation idleAnim;
-Animation walkAnim;
-Animation deathAnim;
+    float frameTime;        // Segundos por frame
+    AnimLoopMode loop;      // Qué pasa al acabar
+    AnimFrame frames[ANIM_MAX_FRAMES][2];   // [frame][volteado]
+} AnimClip;
+
+// Clips globales del jugador
+AnimClip idleAnim;
+AnimClip walkAnim;
+AnimClip deathAnim;
 
 // Estado del jugador
 typedef enum {
@@ -32,140 +48,201 @@ typedef enum {
     PLAYER_DEATH
 } PlayerState;
 
-PlayerState playerState = PLAYER_IDLE;
+// Posición dentro de un clip (lo único de cada entidad)
+typedef struct AnimCursor {
+    int frame;
+    float timer;
+} AnimCursor;
+
+// Animación de un jugador: los clips son comunes (idleAnim, walkAnim,
+// deathAnim); el estado y el frame son de cada jugador
+typedef struct PlayerAnim {
+    PlayerState state;
+    bool facingRight;       // true = derecha, false = izquierda
+    AnimCursor clip[3];     // Posición en cada animación (por PlayerState)
+} PlayerAnim;
+
+// ----------------------------------------------------------------------
+// Base de animaciones: se lee entera la primera vez que se pide un clip.
+// Se busca junto al ejecutable (no depende del directorio desde el que se
+// lance el juego) y, si no está ahí, en el directorio actual (headless,
+// bench y las herramientas no enlazan raylib y solo miran este).
+// Sin base ningún clip tiene frames: se avisa una vez, claro, en vez de
+// un aviso por cada clip que falta.
+// ----------------------------------------------------------------------
+static AnimDb animDb;
+
+const AnimDb *GetAnimDb(void) {
+    static bool tried = false;
+    if (!tried) {
+        tried = true;
+        bool loaded = false;
+#if !defined(GAME_HEADLESS)
+        loaded = LoadAnimDb(&animDb, TextFormat("%s%s", GetApplicationDirectory(), ANIM_DB_PATH));
+#endif
+        if (!loaded) loaded = LoadAnimDb(&animDb, ANIM_DB_PATH);
+        if (!loaded)
+            fprintf(stderr, "animaciones: ERROR: no se encontró una base válida %s (versión %d) junto al "
+                            "ejecutable ni en el directorio actual; ningún personaje se animará. "
+                            "Genérala con \"make anims\".\n", ANIM_DB_PATH, ANIM_DB_VERSION);
+    }
+    return &animDb;
+}
 
-// Dirección del jugador (true = derecha, false = izquierda)
-bool facingRight = true;
+void UnloadAnimDb(void) {
+    FreeAnimDb(&animDb);
+}
 
 // ----------------------------------------------------------------------
-// Cargar animaciones del jugador
+// Datos de reproducción de un clip por su nombre ("perro.andar"...)
+// (sin textura, válido también sin ventana). Si no está en la base queda
+// un clip de un frame que no se ve y se reproduce una sola vez: una muerte
+// sin clip también termina (y el enemigo sale de la lista de muertes).
 // ----------------------------------------------------------------------
-void LoadPlayerAnimations() {
+bool InitAnimClip(AnimClip *clip, const char *name) {
+    const AnimDbClip *c = FindAnimDbClip(GetAnimDb(), name);
+    *clip = (AnimClip){ 0 };
 
-    // -------- IDLE --------
-    idleAnim.texture = LoadTexture("resources/Sprites/Personaje/1 Dog/Idle.png");
-    idleAnim.frameCount = 4;
-    idleAnim.frameSpeed = 8;
-    idleAnim.currentFrame = 0;
-    idleAnim.timer = 0;
-    idleAnim.frameWidth = idleAnim.texture.width / idleAnim.frameCount;
-    idleAnim.frameHeight = idleAnim.texture.height;
-
-    // -------- WALK --------
-    walkAnim.texture = LoadTexture("resources/Sprites/Personaje/1 Dog/Walk.png");
-    walkAnim.frameCount = 6;
-    walkAnim.frameSpeed = 10;
-    walkAnim.currentFrame = 0;
-    walkAnim.timer = 0;
-    walkAnim.frameWidth = walkAnim.texture.width / walkAnim.frameCount;
-    walkAnim.frameHeight = walkAnim.texture.height;
-
-    // -------- DEATH --------
-    deathAnim.texture = LoadTexture("resources/Sprites/Personaje/1 Dog/Death.png");
-    deathAnim.frameCount = 4;
-    deathAnim.frameSpeed = 8;
-    deathAnim.currentFrame = 0;
-    deathAnim.timer = 0;
-    deathAnim.frameWidth = deathAnim.texture.width / deathAnim.frameCount;
-    deathAnim.frameHeight = deathAnim.texture.height;
+    if (c == NULL) {
+        if (GetAnimDb()->header != NULL) fprintf(stderr, "animaciones: falta el clip %s\n", name);
+        clip->frameCount = 1;
+        clip->frameTime = 1.0f;
+        clip->loop = ANIM_ONCE;
+        return false;
+    }
+
+    clip->source = c;
+    clip->frameCount = (c->frameCount < ANIM_MAX_FRAMES) ? (int)c->frameCount : ANIM_MAX_FRAMES;
+    clip->frameTime = c->frameTime;
+    clip->loop = (AnimLoopMode)c->loop;
+    return true;
 }
 
-// ----------------------------------------------------------------------
-// Liberar memoria de animaciones
-// ----------------------------------------------------------------------
-void UnloadPlayerSprites() {
-    UnloadTexture(idleAnim.texture);
-    UnloadTexture(walkAnim.texture);
-    UnloadTexture(deathAnim.texture);
+void InitPlayerAnimations() {
+    InitAnimClip(&idleAnim, "perro.quieto");    // IDLE
+    InitAnimClip(&walkAnim, "perro.andar");     // WALK
+    InitAnimClip(&deathAnim, "perro.morir");    // DEATH
 }
 
+#if !defined(GAME_HEADLESS)
 // ----------------------------------------------------------------------
-// Actualizar animación
+// Cargar la hoja de un clip y precalcular sus frames (zonas de la base,
+// relativas a la hoja)
 // ----------------------------------------------------------------------
-void UpdateAnimation(Animation *anim, float delta) {
+void LoadAnimClip(AnimClip *clip, const char *name) {
+    if (!InitAnimClip(clip, name)) return;
 
-    anim->timer += delta;
+    const AnimDb *db = GetAnimDb();
+    clip->sheet = LoadSprite(db->strings + clip->source->sheet);
 
-    if (anim->timer >= 1.0f / anim->frameSpeed) {
-        anim->timer = 0;
-        anim->currentFrame++;
+    float texW = clip->sheet.texture.width, texH = clip->sheet.texture.height;
 
-        if (anim->currentFrame >= anim->frameCount) {
-            anim->currentFrame = 0;     // Loop
-        }
+    for (int i = 0; i < clip->frameCount; i++) {
+        Rectangle r = db->frames[clip->source->firstFrame + i];
+        Rectangle quad = { -(float)((int)r.width/2), -r.height, r.width, r.height };
+
+        float x0 = clip->sheet.rec.x + r.x, x1 = x0 + r.width;
+        float y0 = clip->sheet.rec.y + r.y, y1 = y0 + r.height;
+
+        clip->frames[i][0] = (AnimFrame){ x0/texW, y0/texH, x1/texW, y1/texH, quad };
+        clip->frames[i][1] = (AnimFrame){ x1/texW, y0/texH, x0/texW, y1/texH, quad };
     }
 }
 
 // ----------------------------------------------------------------------
-// Reiniciar animación desde frame 0
+// Cargar animaciones del jugador
 // ----------------------------------------------------------------------
-void ResetAnimation(Animation *anim) {
-    anim->currentFrame = 0;
-    anim->timer = 0;
+void LoadPlayerAnimations() {
+
+    LoadAnimClip(&idleAnim, "perro.quieto");    // IDLE
+    LoadAnimClip(&walkAnim, "perro.andar");     // WALK
+    LoadAnimClip(&deathAnim, "perro.morir");    // DEATH
 }
 
 // ----------------------------------------------------------------------
-// Saber si animación terminó (para muerte)
+// Liberar memoria de animaciones
 // ----------------------------------------------------------------------
-bool IsAnimationFinished(Animation *anim) {
-    return (anim->currentFrame == anim->frameCount - 1);
+void UnloadPlayerSprites() {
+    UnloadSprite(idleAnim.sheet);
+    UnloadSprite(walkAnim.sheet);
+    UnloadSprite(deathAnim.sheet);
 }
+#endif
 
 // ----------------------------------------------------------------------
-// Dibujo genérico de animación
+// Avanzar una posición dentro de un clip (en bucle o hasta el último
+// frame, según su modo)
 // ----------------------------------------------------------------------
-void DrawAnimation(Animation *anim, Vector2 pos) {
+void UpdateAnimCursor(const AnimClip *clip, AnimCursor *c, float delta) {
 
-    Rectangle src = {
-        anim->frameWidth * anim->currentFrame,
-        0,
-        anim->frameWidth,
-        anim->frameHeight
-    };
+    c->timer += delta;
 
-    // Si mira a la izquierda, dar vuelta al sprite
-    if (!facingRight)
-        src.width = -anim->frameWidth;
+    if (c->timer >= clip->frameTime) {
+        c->timer = 0;
+        c->frame++;
 
-    Rectangle dest = {
-        pos.x - anim->frameWidth/2,
-        pos.y - anim->frameHeight,
-        anim->frameWidth,
-        anim->frameHeight
-    };
+        if (c->frame >= clip->frameCount) {
+            c->frame = (clip->loop == ANIM_ONCE) ? clip->frameCount - 1 : 0;
+        }
+    }
+}
 
-    DrawTexturePro(anim->texture, src, dest, (Vector2){0,0}, 0, WHITE);
+// Saber si el clip llegó a su último frame (para muerte)
+bool IsAnimCursorFinished(const AnimClip *clip, const AnimCursor *c) {
+    return (c->frame == clip->frameCount - 1);
 }
 
 // ----------------------------------------------------------------------
-// Dibujo de la animación correcta según el estado del jugador
+// Animación de cada jugador
 // ----------------------------------------------------------------------
-void DrawPlayer(Vector2 pos)
-{
-    Animation *animToDraw = NULL;
-
-    switch (playerState) {
-        case PLAYER_IDLE:  animToDraw = &idleAnim;  break;
-        case PLAYER_WALK:  animToDraw = &walkAnim;  break;
-        case PLAYER_DEATH: animToDraw = &deathAnim; break;
+static const AnimClip *PlayerClip(PlayerState state) {
+    switch (state) {
+        case PLAYER_WALK:  return &walkAnim;
+        case PLAYER_DEATH: return &deathAnim;
+        default:           return &idleAnim;
     }
+}
 
-    Rectangle src = {
-        animToDraw->frameWidth * animToDraw->currentFrame,
-        0,
-        animToDraw->frameWidth,
-        animToDraw->frameHeight
-    };
+void UpdatePlayerAnim(PlayerAnim *a, float delta) {
+    UpdateAnimCursor(PlayerClip(a->state), &a->clip[a->state], delta);
+}
 
-    if (!facingRight)
-        src.width = -animToDraw->frameWidth;
+void ResetPlayerAnim(PlayerAnim *a, PlayerState state) {
+    a->clip[state] = (AnimCursor){ 0 };
+}
 
-    Rectangle dest = {
-        pos.x - animToDraw->frameWidth / 2,
-        pos.y - animToDraw->frameHeight,
-        animToDraw->frameWidth,
-        animToDraw->frameHeight
-    };
+bool IsPlayerAnimFinished(const PlayerAnim *a) {
+    return IsAnimCursorFinished(PlayerClip(a->state), &a->clip[a->state]);
+}
 
-    DrawTexturePro(animToDraw->texture, src, dest, (Vector2){0,0}, 0.0f, WHITE);
+#if !defined(GAME_HEADLESS)
+// ----------------------------------------------------------------------
+// Dibujo genérico: un frame del clip con los pies en pos. Todo sale de la
+// tabla del clip; solo queda escribir los cuatro vértices en el lote.
+// ----------------------------------------------------------------------
+void DrawAnimFrame(const AnimClip *clip, int frame, bool flipX, Vector2 pos, Color tint) {
+    const AnimFrame *f = &clip->frames[frame][flipX];
+    float x0 = pos.x + f->quad.x, y0 = pos.y + f->quad.y;
+    float x1 = x0 + f->quad.width, y1 = y0 + f->quad.height;
+
+    rlSetTexture(clip->sheet.texture.id);
+    rlBegin(RL_QUADS);
+        rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+
+        rlTexCoord2f(f->u0, f->v0); rlVertex2f(x0, y0);
+        rlTexCoord2f(f->u0, f->v1); rlVertex2f(x0, y1);
+        rlTexCoord2f(f->u1, f->v1); rlVertex2f(x1, y1);
+        rlTexCoord2f(f->u1, f->v0); rlVertex2f(x1, y0);
+    rlEnd();
+    rlSetTexture(0);
+}
+
+// ----------------------------------------------------------------------
+// Dibujo de la animación correcta según el estado del jugador
+// ----------------------------------------------------------------------
+void DrawPlayer(const PlayerAnim *a, Vector2 pos)
+{
+    DrawAnimFrame(PlayerClip(a->state), a->clip[a->state].frame, !a->facingRight, pos, WHITE);
 }
+#endif
@@ -0,0 +1,148 @@
+// animconv.c
+// Conversor de animaciones: texto (.txt) -> base cocinada (.anim)
+// -----------------------------------
+// Uso: animconv entrada.txt salida.anim
+//
+// Formato de texto, un clip por línea ('#' inicia un comentario):
+//   clip nombre frames fps modo hoja
+//     nombre   "personaje.accion" (lo que pide el juego, ver InitAnimClip)
+//     frames   número de frames, en fila de izquierda a derecha
+//     fps      frames por segundo
+//     modo     bucle | una (se para al acabar)
+//     hoja     ruta dentro de resources/Sprites (el resto de la línea)
+//
+// El tamaño de cada hoja se lee de la imagen, así que las zonas de los
+// frames quedan resueltas en el .anim y el juego no abre ninguna imagen
+// para saberlas.
+
+#include "raylib.h"
+#include "level.c"          // SaveLevelImage
+#include "animdb.c"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "external/stb_image.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ANIM_SPRITES_ROOT "resources/Sprites/"
+
+// Array que crece al añadir (solo para la herramienta)
+static void *Push(void *data, int *count, int *capacity, size_t elemSize) {
+    if (*count == *capacity) {
+        *capacity = (*capacity > 0) ? *capacity*2 : 64;
+        data = realloc(data, (size_t)*capacity*elemSize);
+        if (data == NULL) { fprintf(stderr, "animconv: sin memoria\n"); exit(1); }
+    }
+    (*count)++;
+    return data;
+}
+
+static char *CopyString(const char *s) {
+    char *c = malloc(strlen(s) + 1);
+    strcpy(c, s);
+    return c;
+}
+
+int main(int argc, char **argv) {
+
+    if (argc != 3) {
+        fprintf(stderr, "uso: animconv entrada.txt salida.anim\n");
+        return 1;
+    }
+
+    FILE *f = fopen(argv[1], "r");
+    if (f == NULL) {
+        fprintf(stderr, "animconv: no se pudo abrir %s\n", argv[1]);
+        return 1;
+    }
+
+    AnimDbSource *clip = NULL;
+    int clipCount = 0, clipCap = 0;
+
+    char line[1024];
+    int lineNo = 0;
+    int errors = 0;
+
+    while (fgets(line, sizeof(line), f) != NULL) {
+        lineNo++;
+
+        char *hash = strchr(line, '#');
+        if (hash != NULL) *hash = '\0';
+
+        char word[32];
+        if (sscanf(line, "%31s", word) != 1) continue;     // línea vacía
+
+        char name[64], mode[16];
+        int frames, sheetAt = 0;
+        float fps;
+
+        if (strcmp(word, "clip") != 0 ||
+            sscanf(line, "%*s %63s %d %f %15s %n", name, &frames, &fps, mode, &sheetAt) != 4 || sheetAt == 0) {
+            fprintf(stderr, "%s:%d: línea no válida: %s", argv[1], lineNo, line);
+            errors++;
+            continue;
+        }
+
+        // Hoja: el resto de la línea, sin espacios al final
+        char *sheet = line + sheetAt;
+        size_t len = strlen(sheet);
+        while (len > 0 && (sheet[len - 1] == '\n' || sheet[len - 1] == '\r' || sheet[len - 1] == ' ' || sheet[len - 1] == '\t'))
+            sheet[--len] = '\0';
+
+        bool loop = strcmp(mode, "bucle") == 0;
+        if (!loop && strcmp(mode, "una") != 0) {
+            fprintf(stderr, "%s:%d: modo no válido '%s' (bucle o una)\n", argv[1], lineNo, mode);
+            errors++;
+            continue;
+        }
+        if (frames <= 0 || frames > 32 || fps <= 0 || len == 0) {
+            fprintf(stderr, "%s:%d: clip %s: frames (1..32), fps u hoja no válidos\n", argv[1], lineNo, name);
+            errors++;
+            continue;
+        }
+
+        char path[1024];
+        snprintf(path, sizeof(path), "%s%s", ANIM_SPRITES_ROOT, sheet);
+        int w, h, comp;
+        if (!stbi_info(path, &w, &h, &comp)) {
+            fprintf(stderr, "%s:%d: no se pudo leer la hoja %s\n", argv[1], lineNo, path);
+            errors++;
+            continue;
+        }
+        if (w % frames != 0)
+            fprintf(stderr, "%s:%d: aviso: %s mide %d de ancho, no divisible en %d frames\n", argv[1], lineNo, path, w, frames);
+
+        clip = Push(clip, &clipCount, &clipCap, sizeof(AnimDbSource));
+        clip[clipCount - 1] = (AnimDbSource){ CopyString(name), CopyString(path), frames, fps,
+                                              loop ? ANIM_LOOP : ANIM_ONCE, w, h };
+    }
+    fclose(f);
+
+    // Nombres repetidos (las huellas iguales las rechaza BuildAnimDbImage)
+    for (int i = 0; i < clipCount; i++)
+        for (int j = i + 1; j < clipCount; j++)
+            if (strcmp(clip[i].name, clip[j].name) == 0) {
+                fprintf(stderr, "%s: clip %s repetido\n", argv[1], clip[i].name);
+                errors++;
+            }
+
+    if (errors == 0) {
+        size_t size = 0;
+        void *image = BuildAnimDbImage(clip, clipCount, &size);
+        if (image == NULL || !SaveLevelImage(argv[2], image, size)) {
+            fprintf(stderr, "animconv: no se pudo escribir %s\n", argv[2]);
+            errors++;
+        }
+        else printf("%s: %d clips, %zu bytes\n", argv[2], clipCount, size);
+        free(image);
+    }
+
+    for (int i = 0; i < clipCount; i++) {
+        free((char *)clip[i].name);
+        free((char *)clip[i].sheet);
+    }
+    free(clip);
+    return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,241 @@
+// animdb.c
+// Base de datos de animaciones cocinada (.anim)
+// -----------------------------------
+// Todos los clips del juego (jugador y enemigos) van en un solo archivo
+// binario que se lee de una vez y se usa en el sitio, sin parseo. Cada
+// clip se busca por la huella (FNV-1a) de su nombre ("perro.andar",
+// "rata.morir"...), por bisección en la tabla ordenada. Añadir un
+// personaje es añadir líneas al texto y volver a cocinarlo con animconv
+// ("make anims"), sin tocar código.
+//
+// Formato (little endian, todo alineado a 4 bytes):
+//   AnimDbHeader
+//   AnimDbClip  clips[clipCount]       ordenados por nameHash
+//   Rectangle   frames[frameCount]     zona de cada frame dentro de su hoja
+//   char        strings[stringSize]    nombres y rutas, terminados en 0
+//
+// Los .anim se generan desde texto con animconv (ver animconv.c).
+
+#include "raylib.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define ANIM_DB_VERSION 1
+#define ANIM_DB_PATH "resources/Animations/animaciones.anim"
+
+// Qué pasa al acabar el último frame
+typedef enum {
+    ANIM_LOOP = 0,              // Vuelve al primero
+    ANIM_ONCE                   // Se para (ver UpdateAnimCursor y AnimateEnemies)
+} AnimLoopMode;
+
+typedef struct AnimDbHeader {
+    char magic[4];              // "PANM"
+    uint32_t version;
+    uint32_t fileSize;
+    uint32_t clipCount;
+    uint32_t clipOffset;
+    uint32_t frameCount;
+    uint32_t frameOffset;
+    uint32_t stringSize;
+    uint32_t stringOffset;
+} AnimDbHeader;
+
+typedef struct AnimDbClip {
+    uint32_t nameHash;          // AnimNameHash(nombre)
+    uint32_t name;              // Offsets en strings
+    uint32_t sheet;             // Ruta de la hoja (resources/Sprites/...)
+    uint32_t firstFrame, frameCount;    // Rango en frames
+    float frameTime;            // Segundos por frame
+    uint32_t loop;              // AnimLoopMode
+} AnimDbClip;
+
+// Base cargada: punteros dentro del bloque leído
+typedef struct AnimDb {
+    void *data;
+    size_t size;
+    const AnimDbHeader *header;
+    const AnimDbClip *clips;
+    const Rectangle *frames;
+    const char *strings;
+} AnimDb;
+
+// Clip al construir una base (herramientas)
+typedef struct AnimDbSource {
+    const char *name;
+    const char *sheet;
+    int frameCount;
+    float fps;
+    AnimLoopMode loop;
+    int sheetWidth, sheetHeight;    // Frames en fila, de izquierda a derecha
+} AnimDbSource;
+
+// ----------------------------------------------------------------------
+// Huella del nombre (FNV-1a de 32 bits)
+// ----------------------------------------------------------------------
+uint32_t AnimNameHash(const char *name) {
+    uint32_t h = 2166136261u;
+    for (; *name; name++) {
+        h ^= (unsigned char)*name;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static bool AnimSectionFits(size_t size, uint32_t offset, uint32_t count, size_t elem) {
+    return (offset % 4 == 0) && offset >= sizeof(AnimDbHeader) &&
+           (uint64_t)offset + (uint64_t)count*elem <= size;
+}
+
+// ----------------------------------------------------------------------
+// Cargar (una sola lectura del archivo) / liberar
+// ----------------------------------------------------------------------
+void FreeAnimDb(AnimDb *db) {
+    free(db->data);
+    *db = (AnimDb){ 0 };
+}
+
+bool LoadAnimDb(AnimDb *db, const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) return false;
+    fseek(f, 0, SEEK_END);
+    long end = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (end < (long)sizeof(AnimDbHeader)) { fclose(f); return false; }
+
+    size_t size = (size_t)end;
+    unsigned char *data = malloc(size);
+    bool read = data != NULL && fread(data, 1, size, f) == size;
+    fclose(f);
+    if (!read) { free(data); return false; }
+
+    const AnimDbHeader *h = (const AnimDbHeader *)data;
+    bool valid = memcmp(h->magic, "PANM", 4) == 0 &&
+        h->version == ANIM_DB_VERSION &&
+        h->fileSize == size &&
+        AnimSectionFits(size, h->clipOffset, h->clipCount, sizeof(AnimDbClip)) &&
+        AnimSectionFits(size, h->frameOffset, h->frameCount, sizeof(Rectangle)) &&
+        AnimSectionFits(size, h->stringOffset, h->stringSize, 1) &&
+        h->stringSize > 0 && data[h->stringOffset + h->stringSize - 1] == '\0';
+
+    // Cada clip dentro de sus secciones
+    const AnimDbClip *clips = (const AnimDbClip *)(data + h->clipOffset);
+    for (uint32_t i = 0; valid && i < h->clipCount; i++) {
+        const AnimDbClip *c = &clips[i];
+        valid = c->frameCount > 0 && c->frameTime > 0 &&
+                (uint64_t)c->firstFrame + c->frameCount <= h->frameCount &&
+                c->name < h->stringSize && c->sheet < h->stringSize &&
+                (i == 0 || clips[i - 1].nameHash <= c->nameHash);
+    }
+
+    if (!valid) { free(data); return false; }
+
+    FreeAnimDb(db);
+    db->data = data;
+    db->size = size;
+    db->header = h;
+    db->clips = clips;
+    db->frames = (const Rectangle *)(data + h->frameOffset);
+    db->strings = (const char *)(data + h->stringOffset);
+    return true;
+}
+
+// ----------------------------------------------------------------------
+// Buscar un clip por nombre (NULL si no está)
+// ----------------------------------------------------------------------
+const AnimDbClip *FindAnimDbClip(const AnimDb *db, const char *name) {
+    if (db->header == NULL) return NULL;
+
+    uint32_t hash = AnimNameHash(name);
+    int lo = 0, hi = (int)db->header->clipCount - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi)/2;
+        uint32_t h = db->clips[mid].nameHash;
+        if (h < hash) lo = mid + 1;
+        else if (h > hash) hi = mid - 1;
+        else return (strcmp(db->strings + db->clips[mid].name, name) == 0) ? &db->clips[mid] : NULL;
+    }
+    return NULL;
+}
+
+// ----------------------------------------------------------------------
+// Construir una base en memoria (mismo contenido que el .anim).
+// Devuelve un bloque de malloc, o NULL si dos nombres dan la misma huella.
+// ----------------------------------------------------------------------
+static int CompareSourceHash(const void *a, const void *b) {
+    uint32_t ha = AnimNameHash(((const AnimDbSource *)a)->name);
+    uint32_t hb = AnimNameHash(((const AnimDbSource *)b)->name);
+    return (ha > hb) - (ha < hb);
+}
+
+static size_t Align4(size_t n) { return (n + 3) & ~(size_t)3; }
+
+void *BuildAnimDbImage(const AnimDbSource *source, int count, size_t *outSize) {
+    AnimDbSource *sorted = malloc((size_t)(count > 0 ? count : 1)*sizeof(AnimDbSource));
+    memcpy(sorted, source, (size_t)count*sizeof(AnimDbSource));
+    qsort(sorted, count, sizeof(AnimDbSource), CompareSourceHash);
+
+    for (int i = 1; i < count; i++) {
+        if (AnimNameHash(sorted[i].name) == AnimNameHash(sorted[i - 1].name)) {
+            fprintf(stderr, "animdb: %s y %s tienen la misma huella\n", sorted[i - 1].name, sorted[i].name);
+            free(sorted);
+            return NULL;
+        }
+    }
+
+    size_t frameCount = 0, stringSize = 0;
+    for (int i = 0; i < count; i++) {
+        frameCount += sorted[i].frameCount;
+        stringSize += strlen(sorted[i].name) + 1 + strlen(sorted[i].sheet) + 1;
+    }
+
+    size_t clipOffset = Align4(sizeof(AnimDbHeader));
+    size_t frameOffset = Align4(clipOffset + (size_t)count*sizeof(AnimDbClip));
+    size_t stringOffset = Align4(frameOffset + frameCount*sizeof(Rectangle));
+    size_t size = Align4(stringOffset + stringSize);
+
+    unsigned char *image = calloc(size, 1);
+    AnimDbHeader *h = (AnimDbHeader *)image;
+    memcpy(h->magic, "PANM", 4);
+    h->version = ANIM_DB_VERSION;
+    h->fileSize = (uint32_t)size;
+    h->clipCount = (uint32_t)count;
+    h->clipOffset = (uint32_t)clipOffset;
+    h->frameCount = (uint32_t)frameCount;
+    h->frameOffset = (uint32_t)frameOffset;
+    h->stringSize = (uint32_t)(size - stringOffset);
+    h->stringOffset = (uint32_t)stringOffset;
+
+    AnimDbClip *clips = (AnimDbClip *)(image + clipOffset);
+    Rectangle *frames = (Rectangle *)(image + frameOffset);
+    char *strings = (char *)(image + stringOffset);
+    uint32_t frame = 0, str = 0;
+
+    for (int i = 0; i < count; i++) {
+        const AnimDbSource *s = &sorted[i];
+        AnimDbClip *c = &clips[i];
+
+        c->nameHash = AnimNameHash(s->name);
+        c->name = str;
+        strcpy(strings + str, s->name);
+        str += (uint32_t)strlen(s->name) + 1;
+        c->sheet = str;
+        strcpy(strings + str, s->sheet);
+        str += (uint32_t)strlen(s->sheet) + 1;
+
+        c->firstFrame = frame;
+        c->frameCount = (uint32_t)s->frameCount;
+        c->frameTime = 1.0f / s->fps;
+        c->loop = (uint32_t)s->loop;
+
+        int w = s->sheetWidth / s->frameCount;
+        for (int k = 0; k < s->frameCount; k++)
+            frames[frame++] = (Rectangle){ (float)(w*k), 0, (float)w, (float)s->sheetHeight };
+    }
+
+    free(sorted);
+    *outSize = size;
+    return image;
+}
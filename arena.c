@@ -0,0 +1,129 @@
+// arena.c
+// Memoria por nivel: una sola reserva que se vacía de golpe
+// -----------------------------------
+// Todo lo que vive lo mismo que el nivel (tramos de patrulla, estado de
+// carga por trozo, casillas) y lo que vive lo mismo que una partida
+// (almacenes de entidades) sale de aquí, uno detrás de otro. Nada se libera
+// suelto: al reiniciar se vuelve a una marca y al cambiar de nivel se vacía
+// todo, las dos cosas en O(1) y sin fragmentar el montón.
+//
+// La memoria es una reserva de direcciones (ARENA_RESERVE) que el sistema
+// solo respalda con páginas al tocarlas; en Linux se piden páginas grandes
+// (transparent huge pages). Un array que crece dentro de la arena se copia
+// detrás y el hueco viejo se recupera en el siguiente vaciado.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#if defined(_WIN32)
+    // Sin windows.h (choca con raylib): solo lo necesario de la API
+    __declspec(dllimport) void *__stdcall VirtualAlloc(void *address, size_t size, unsigned long type, unsigned long protect);
+    __declspec(dllimport) int __stdcall VirtualFree(void *address, size_t size, unsigned long type);
+    #define ARENA_MEM_COMMIT    0x00001000
+    #define ARENA_MEM_RESERVE   0x00002000
+    #define ARENA_MEM_RELEASE   0x00008000
+    #define ARENA_PAGE_RW       0x04
+#else
+    #include <sys/mman.h>
+#endif
+
+#ifndef ARENA_RESERVE
+#define ARENA_RESERVE ((size_t)1 << (sizeof(void *) > 4 ? 32 : 28))   // Direcciones reservadas
+#endif
+#define ARENA_ALIGN 64                              // Cada bloque empieza en su línea de caché
+#define ARENA_COMMIT_STEP ((size_t)1 << 20)         // Windows: se confirma de 1 MB en 1 MB
+#define ARENA_HUGE_PAGE ((size_t)2 << 20)
+
+typedef struct Arena {
+    unsigned char *base;
+    size_t reserved;
+    size_t committed;       // Bytes respaldados (solo Windows; en POSIX = reserved)
+    size_t used;
+    size_t peak;            // Máximo usado desde que se creó
+} Arena;
+
+// ----------------------------------------------------------------------
+// Crear / liberar
+// ----------------------------------------------------------------------
+bool InitArena(Arena *a) {
+    *a = (Arena){ 0 };
+
+#if defined(_WIN32)
+    void *mem = VirtualAlloc(NULL, ARENA_RESERVE, ARENA_MEM_RESERVE, ARENA_PAGE_RW);
+    if (mem == NULL) return false;
+    a->base = mem;
+    a->reserved = ARENA_RESERVE;
+#else
+    // Solo direcciones: MAP_NORESERVE no cuenta la reserva entera como usada
+    size_t size = ARENA_RESERVE + ARENA_HUGE_PAGE;
+    void *mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (mem == MAP_FAILED) return false;
+
+    // Alinear a página grande y devolver los bordes sobrantes
+    uintptr_t start = ((uintptr_t)mem + ARENA_HUGE_PAGE - 1) & ~(uintptr_t)(ARENA_HUGE_PAGE - 1);
+    size_t head = start - (uintptr_t)mem;
+    if (head > 0) munmap(mem, head);
+    if (ARENA_HUGE_PAGE - head > 0) munmap((unsigned char *)start + ARENA_RESERVE, ARENA_HUGE_PAGE - head);
+
+    a->base = (unsigned char *)start;
+    a->reserved = ARENA_RESERVE;
+    a->committed = ARENA_RESERVE;
+    #if defined(MADV_HUGEPAGE)
+    madvise(a->base, a->reserved, MADV_HUGEPAGE);
+    #endif
+#endif
+    return true;
+}
+
+void FreeArena(Arena *a) {
+    if (a->base == NULL) return;
+#if defined(_WIN32)
+    VirtualFree(a->base, 0, ARENA_MEM_RELEASE);
+#else
+    munmap(a->base, a->reserved);
+#endif
+    *a = (Arena){ 0 };
+}
+
+// ----------------------------------------------------------------------
+// Reservar (sin inicializar) y vaciar
+// ----------------------------------------------------------------------
+void *ArenaAlloc(Arena *a, size_t size) {
+    size_t start = (a->used + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+
+    if (a->base == NULL || size > a->reserved - start) {
+        fprintf(stderr, "arena: sin memoria para %zu bytes (%zu en uso)\n", size, a->used);
+        exit(1);
+    }
+
+#if defined(_WIN32)
+    if (start + size > a->committed) {
+        size_t commit = (start + size - a->committed + ARENA_COMMIT_STEP - 1) & ~(ARENA_COMMIT_STEP - 1);
+        if (commit > a->reserved - a->committed) commit = a->reserved - a->committed;
+        if (VirtualAlloc(a->base + a->committed, commit, ARENA_MEM_COMMIT, ARENA_PAGE_RW) == NULL) {
+            fprintf(stderr, "arena: no se pudo confirmar memoria\n");
+            exit(1);
+        }
+        a->committed += commit;
+    }
+#endif
+
+    a->used = start + size;
+    if (a->used > a->peak) a->peak = a->used;
+    return a->base + start;
+}
+
+// Copia un array a un bloque nuevo más grande (el viejo queda hasta el vaciado)
+void *ArenaGrow(Arena *a, void *data, size_t oldSize, size_t size) {
+    void *p = ArenaAlloc(a, size);
+    if (data != NULL && oldSize > 0) memcpy(p, data, oldSize < size ? oldSize : size);
+    return p;
+}
+
+// Marca: todo lo reservado después se suelta con ArenaRewind
+size_t ArenaMark(const Arena *a) { return a->used; }
+void ArenaRewind(Arena *a, size_t mark) { if (mark < a->used) a->used = mark; }
+void ArenaReset(Arena *a) { a->used = 0; }
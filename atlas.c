@@ -0,0 +1,92 @@
+// atlas.c
+// Sprites desde los atlas empaquetados (atlaspack.c, "make atlas")
+// -----------------------------------
+// Un Sprite es una textura y la zona que ocupa dentro de ella. Los
+// cargadores piden cada imagen por su ruta de siempre; si está en la tabla
+// generada (atlas_table.c) se devuelve su zona en la página del atlas, que
+// se carga la primera vez que hace falta y se comparte. Todo lo dibujado
+// desde una misma página va en el mismo lote de raylib.
+//
+// Una imagen que aún no se ha empaquetado se carga suelta como antes
+// (basta con volver a hacer "make atlas" para meterla).
+
+#include "raylib.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct Sprite {
+    Texture2D texture;      // Página del atlas o textura propia
+    Rectangle rec;          // Zona del sprite en la textura
+    int page;               // Página del atlas (-1 = textura propia)
+} Sprite;
+
+#if !defined(GAME_HEADLESS)
+typedef struct AtlasPage {
+    const char *path;
+    int width, height;
+    Rectangle white;        // Centro del bloque blanco, para figuras (ver UseAtlasForShapes)
+} AtlasPage;
+
+typedef struct AtlasEntry {
+    const char *name;       // Ruta relativa a ATLAS_ROOT
+    int page;
+    Rectangle rec;
+} AtlasEntry;
+
+#include "atlas_table.c"    // Generado por atlaspack
+
+static Texture2D atlasTexture[ATLAS_PAGES];
+
+static int CompareAtlasEntry(const void *key, const void *entry) {
+    return strcmp((const char *)key, ((const AtlasEntry *)entry)->name);
+}
+
+// ------------------------------
+// Cargar un sprite por su ruta (resources/Sprites/...)
+// ------------------------------
+Sprite LoadSprite(const char *path) {
+    size_t rootLen = strlen(ATLAS_ROOT);
+    const AtlasEntry *e = NULL;
+
+    if (strncmp(path, ATLAS_ROOT, rootLen) == 0)
+        e = bsearch(path + rootLen, atlasEntries, ATLAS_ENTRIES, sizeof(AtlasEntry), CompareAtlasEntry);
+
+    if (e == NULL || !FileExists(atlasPages[e->page].path)) {
+        Texture2D t = LoadTexture(path);
+        return (Sprite){ t, { 0, 0, t.width, t.height }, -1 };
+    }
+
+    if (atlasTexture[e->page].id == 0) atlasTexture[e->page] = LoadTexture(atlasPages[e->page].path);
+    return (Sprite){ atlasTexture[e->page], e->rec, e->page };
+}
+
+// Las páginas del atlas se liberan juntas en UnloadAtlas
+void UnloadSprite(Sprite s) {
+    if (s.page < 0) UnloadTexture(s.texture);
+}
+
+void UnloadAtlas(void) {
+    SetShapesTexture((Texture2D){ 0 }, (Rectangle){ 0 });     // Vuelve al píxel de raylib
+    for (int p = 0; p < ATLAS_PAGES; p++) {
+        if (atlasTexture[p].id != 0) UnloadTexture(atlasTexture[p]);
+        atlasTexture[p] = (Texture2D){ 0 };
+    }
+}
+
+// Las figuras (DrawRectangle, DrawCircle...) se pintan con el bloque
+// blanco de la página del sprite: no cortan el lote entre sprites
+void UseAtlasForShapes(Sprite s) {
+    if (s.page >= 0) SetShapesTexture(s.texture, atlasPages[s.page].white);
+}
+
+// ------------------------------
+// Dibujo
+// ------------------------------
+void DrawSpritePro(Sprite s, Rectangle dest, Color tint) {
+    DrawTexturePro(s.texture, s.rec, dest, (Vector2){ 0, 0 }, 0, tint);
+}
+
+void DrawSprite(Sprite s, float x, float y, Color tint) {
+    DrawSpritePro(s, (Rectangle){ x, y, s.rec.width, s.rec.height }, tint);
+}
+#endif
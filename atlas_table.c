@@ -0,0 +1,54 @@
+// atlas_table.c
+// Generado por atlaspack (make atlas) a partir de resources/Sprites: no editar a mano
+
+#define ATLAS_PAGES 2
+#define ATLAS_ROOT "resources/Sprites/"
+
+static const AtlasPage atlasPages[ATLAS_PAGES] = {
+    { "resources/Atlas/atlas0.png", 2048, 2048, { 1, 1, 2, 2 } },
+    { "resources/Atlas/atlas1.png", 2048, 2048, { 1, 1, 2, 2 } },
+};
+
+#define ATLAS_ENTRIES 40
+static const AtlasEntry atlasEntries[ATLAS_ENTRIES] = {
+    { "Enemigos/5 Rat/Death.png", 0, { 1846, 234, 128, 32 } },
+    { "Enemigos/5 Rat/Hurt.png", 0, { 1976, 234, 64, 32 } },
+    { "Enemigos/5 Rat/Idle.png", 0, { 1846, 268, 128, 32 } },
+    { "Enemigos/5 Rat/Walk.png", 0, { 1846, 302, 128, 32 } },
+    { "Enemigos/6 Rat 2/Death.png", 0, { 1976, 268, 64, 32 } },
+    { "Enemigos/6 Rat 2/Hurt.png", 0, { 1976, 302, 64, 32 } },
+    { "Enemigos/6 Rat 2/Idle.png", 0, { 1846, 336, 128, 32 } },
+    { "Enemigos/6 Rat 2/Walk.png", 0, { 1846, 370, 128, 32 } },
+    { "Enemigos/7 Bird/Death.png", 0, { 1846, 404, 128, 32 } },
+    { "Enemigos/7 Bird/Hurt.png", 0, { 1976, 336, 64, 32 } },
+    { "Enemigos/7 Bird/Idle.png", 0, { 1846, 438, 128, 32 } },
+    { "Enemigos/7 Bird/Walk.png", 0, { 1846, 200, 192, 32 } },
+    { "Enemigos/Enemigo/Mushroom-Die.png", 0, { 642, 683, 1200, 64 } },
+    { "Enemigos/Enemigo/Mushroom-Idle.png", 0, { 1284, 749, 560, 64 } },
+    { "Enemigos/Enemigo/Mushroom-Run.png", 0, { 642, 749, 640, 64 } },
+    { "Menu/Logo.png", 1, { 6, 0, 1536, 1024 } },
+    { "Menu/PixelGUI/PixelGUI/ClickIcon.png", 1, { 592, 1288, 360, 260 } },
+    { "Menu/PixelGUI/PixelGUI/ExitBtn.png", 1, { 0, 1026, 590, 260 } },
+    { "Menu/PixelGUI/PixelGUI/ExitClick.png", 1, { 0, 1550, 590, 240 } },
+    { "Menu/PixelGUI/PixelGUI/ExitIcon.png", 1, { 954, 1288, 360, 260 } },
+    { "Menu/PixelGUI/PixelGUI/ExitIconClick.png", 1, { 592, 1792, 360, 230 } },
+    { "Menu/PixelGUI/PixelGUI/OptBtn.png", 1, { 592, 1026, 590, 260 } },
+    { "Menu/PixelGUI/PixelGUI/OptClick.png", 1, { 592, 1550, 590, 240 } },
+    { "Menu/PixelGUI/PixelGUI/OptIcon.png", 1, { 1316, 1288, 360, 260 } },
+    { "Menu/PixelGUI/PixelGUI/OptIconClick.png", 1, { 954, 1792, 360, 230 } },
+    { "Menu/PixelGUI/PixelGUI/PlayBtn.png", 1, { 1184, 1026, 590, 260 } },
+    { "Menu/PixelGUI/PixelGUI/PlayClick.png", 1, { 1184, 1550, 590, 240 } },
+    { "Menu/PixelGUI/PixelGUI/PlayIconClick.png", 1, { 1678, 1792, 360, 229 } },
+    { "Menu/PixelGUI/PixelGUI/layer1.png", 1, { 1678, 1288, 360, 260 } },
+    { "Menu/PixelGUI/PixelGUI/layer2.png", 1, { 1316, 1792, 360, 230 } },
+    { "Menu/PixelGUI/PixelGUI/layer3.png", 1, { 0, 1288, 590, 260 } },
+    { "Menu/PixelGUI/PixelGUI/layer4.png", 1, { 0, 1792, 590, 240 } },
+    { "Personaje/1 Dog/Attack.png", 0, { 1846, 0, 192, 48 } },
+    { "Personaje/1 Dog/Death.png", 0, { 1846, 50, 192, 48 } },
+    { "Personaje/1 Dog/Hurt.png", 0, { 1846, 150, 96, 48 } },
+    { "Personaje/1 Dog/Idle.png", 0, { 1846, 100, 192, 48 } },
+    { "Personaje/1 Dog/Walk.png", 0, { 642, 815, 288, 48 } },
+    { "Plataformas/cielo atardacer.png", 0, { 0, 683, 640, 360 } },
+    { "Plataformas/cielo.png", 0, { 6, 0, 1600, 681 } },
+    { "Plataformas/suelo.png", 0, { 1846, 472, 96, 32 } },
+};
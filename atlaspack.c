@@ -0,0 +1,325 @@
+// atlaspack.c
+// Empaquetador de sprites: resources/Sprites -> atlas PNG + tabla en C
+// -----------------------------------
+// Uso: atlaspack carpeta prefijo tabla.c [grupo ...]
+//   carpeta   raíz de los sprites (se recorre entera, solo .png)
+//   prefijo   ruta de las páginas: prefijo0.png, prefijo1.png...
+//   tabla.c   tabla generada que leen los cargadores (atlas.c)
+//   grupo     carpetas de primer nivel separadas por comas que comparten
+//             página, p. ej. "Personaje,Enemigos,Plataformas". Lo que no
+//             esté en ningún grupo va a un último grupo aparte.
+//
+// Cada grupo se empaqueta con stb_rect_pack en páginas de hasta
+// ATLAS_MAX_SIZE; si no cabe sigue en otra página. Así lo que se dibuja
+// junto (todo el mundo de juego) acaba en la misma textura y el lote de
+// raylib no se corta al cambiar de sprite. Cada página lleva además un
+// bloque blanco para dibujar figuras (SetShapesTexture) sin cambiar de
+// textura.
+//
+// Los nombres de la tabla son la ruta relativa a la carpeta raíz
+// ("Personaje/1 Dog/Idle.png"), ordenados para buscarlos por bisección.
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "external/stb_image.h"
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "external/stb_image_write.h"
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "external/stb_rect_pack.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#define ATLAS_MAX_SIZE 2048     // Lado máximo de una página
+#define ATLAS_PADDING 2         // Píxeles transparentes a la derecha y debajo de cada sprite
+#define ATLAS_WHITE 4           // Lado del bloque blanco de cada página
+#define ATLAS_MAX_GROUPS 16
+#define ATLAS_PATH_MAX 512
+
+typedef struct SpriteFile {
+    char name[ATLAS_PATH_MAX];  // Relativo a la raíz, con '/'
+    int group;
+    int width, height;
+    unsigned char *pixels;      // RGBA
+    int page;                   // -1 = sin colocar
+    int x, y;
+} SpriteFile;
+
+static SpriteFile *sprites = NULL;
+static int spriteCount = 0, spriteCap = 0;
+
+static char groupFolders[ATLAS_MAX_GROUPS][ATLAS_PATH_MAX];
+static int groupCount = 0;
+
+// ------------------------------
+// Recorrer la carpeta
+// ------------------------------
+static bool IsPng(const char *name) {
+    size_t n = strlen(name);
+    if (n < 4) return false;
+    const char *ext = name + n - 4;
+    return ext[0] == '.' && tolower(ext[1]) == 'p' && tolower(ext[2]) == 'n' && tolower(ext[3]) == 'g';
+}
+
+// Grupo de un sprite según su carpeta de primer nivel (groupCount = el resto)
+static int GroupOf(const char *name) {
+    const char *slash = strchr(name, '/');
+    size_t len = (slash != NULL) ? (size_t)(slash - name) : 0;
+
+    for (int g = 0; g < groupCount; g++) {
+        const char *list = groupFolders[g];
+        while (*list) {
+            const char *comma = strchr(list, ',');
+            size_t n = (comma != NULL) ? (size_t)(comma - list) : strlen(list);
+            if (n == len && len > 0 && strncmp(list, name, n) == 0) return g;
+            list += n + (comma != NULL);
+        }
+    }
+    return groupCount;
+}
+
+static void AddSprite(const char *root, const char *name) {
+    char path[ATLAS_PATH_MAX*2];
+    snprintf(path, sizeof(path), "%s/%s", root, name);
+
+    int w, h, channels;
+    unsigned char *pixels = stbi_load(path, &w, &h, &channels, 4);
+    if (pixels == NULL) {
+        fprintf(stderr, "atlaspack: no se pudo leer %s (%s)\n", path, stbi_failure_reason());
+        exit(1);
+    }
+
+    if (spriteCount == spriteCap) {
+        spriteCap = (spriteCap > 0) ? spriteCap*2 : 64;
+        sprites = realloc(sprites, (size_t)spriteCap*sizeof(SpriteFile));
+        if (sprites == NULL) { fprintf(stderr, "atlaspack: sin memoria\n"); exit(1); }
+    }
+
+    SpriteFile *s = &sprites[spriteCount++];
+    snprintf(s->name, sizeof(s->name), "%s", name);
+    s->group = GroupOf(name);
+    s->width = w;
+    s->height = h;
+    s->pixels = pixels;
+    s->page = -1;
+}
+
+// prefix: ruta relativa ya recorrida ("" en la raíz)
+static void ScanFolder(const char *root, const char *prefix) {
+    char dirPath[ATLAS_PATH_MAX*2];
+    snprintf(dirPath, sizeof(dirPath), "%s/%s", root, prefix);
+
+    DIR *dir = opendir(dirPath);
+    if (dir == NULL) {
+        fprintf(stderr, "atlaspack: no se pudo abrir %s\n", dirPath);
+        exit(1);
+    }
+
+    struct dirent *e;
+    while ((e = readdir(dir)) != NULL) {
+        // Ocultos y restos de macOS fuera
+        if (e->d_name[0] == '.' || strcmp(e->d_name, "__MACOSX") == 0) continue;
+
+        char name[ATLAS_PATH_MAX];
+        snprintf(name, sizeof(name), "%s%s", prefix, e->d_name);
+
+        char full[ATLAS_PATH_MAX*2];
+        snprintf(full, sizeof(full), "%s/%s", root, name);
+        struct stat st;
+        if (stat(full, &st) != 0) continue;
+
+        if (S_ISDIR(st.st_mode)) {
+            char sub[ATLAS_PATH_MAX + 1];
+            snprintf(sub, sizeof(sub), "%s/", name);
+            ScanFolder(root, sub);
+        }
+        else if (IsPng(e->d_name)) AddSprite(root, name);
+    }
+    closedir(dir);
+}
+
+static int CompareNames(const void *a, const void *b) {
+    return strcmp(((const SpriteFile *)a)->name, ((const SpriteFile *)b)->name);
+}
+
+// ------------------------------
+// Empaquetar
+// ------------------------------
+typedef struct AtlasPageOut {
+    int width, height;          // Tamaño final (potencia de 2)
+    int group;
+} AtlasPageOut;
+
+static AtlasPageOut *pages = NULL;
+static int pageCount = 0;
+
+static int NextPow2(int v) {
+    int p = 64;
+    while (p < v) p *= 2;
+    return p;
+}
+
+// Coloca los sprites del grupo en páginas nuevas hasta que no quede ninguno
+static void PackGroup(int group) {
+    int count = 0;
+    for (int i = 0; i < spriteCount; i++) if (sprites[i].group == group) count++;
+    if (count == 0) return;
+
+    stbrp_rect *rects = malloc((size_t)count*sizeof(stbrp_rect));
+    stbrp_node *nodes = malloc(ATLAS_MAX_SIZE*sizeof(stbrp_node));
+
+    for (int left = count; left > 0; ) {
+        int n = 0;
+        for (int i = 0; i < spriteCount; i++) {
+            if (sprites[i].group != group || sprites[i].page >= 0) continue;
+            rects[n++] = (stbrp_rect){ .id = i, .w = sprites[i].width + ATLAS_PADDING, .h = sprites[i].height + ATLAS_PADDING };
+        }
+
+        stbrp_context ctx;
+        stbrp_init_target(&ctx, ATLAS_MAX_SIZE, ATLAS_MAX_SIZE, nodes, ATLAS_MAX_SIZE);
+
+        // El bloque blanco primero: queda en (0, 0)
+        stbrp_rect white = { .w = ATLAS_WHITE + ATLAS_PADDING, .h = ATLAS_WHITE + ATLAS_PADDING };
+        stbrp_pack_rects(&ctx, &white, 1);
+        stbrp_pack_rects(&ctx, rects, n);
+
+        int page = pageCount;
+        int usedW = ATLAS_WHITE, usedH = ATLAS_WHITE, placed = 0;
+        for (int k = 0; k < n; k++) {
+            if (!rects[k].was_packed) continue;
+            SpriteFile *s = &sprites[rects[k].id];
+            s->page = page;
+            s->x = rects[k].x;
+            s->y = rects[k].y;
+            if (s->x + s->width > usedW) usedW = s->x + s->width;
+            if (s->y + s->height > usedH) usedH = s->y + s->height;
+            placed++;
+        }
+
+        if (placed == 0) {
+            for (int k = 0; k < n; k++)
+                fprintf(stderr, "atlaspack: %s (%dx%d) no cabe en %dx%d\n", sprites[rects[k].id].name,
+                        sprites[rects[k].id].width, sprites[rects[k].id].height, ATLAS_MAX_SIZE, ATLAS_MAX_SIZE);
+            exit(1);
+        }
+
+        pages = realloc(pages, (size_t)(pageCount + 1)*sizeof(AtlasPageOut));
+        pages[pageCount++] = (AtlasPageOut){ NextPow2(usedW), NextPow2(usedH), group };
+        left -= placed;
+    }
+
+    free(rects);
+    free(nodes);
+}
+
+// ------------------------------
+// Escribir páginas y tabla
+// ------------------------------
+static bool WritePage(int page, const char *prefix) {
+    int w = pages[page].width, h = pages[page].height;
+    unsigned char *image = calloc((size_t)w*h, 4);
+    if (image == NULL) return false;
+
+    for (int y = 0; y < ATLAS_WHITE; y++) memset(image + (size_t)y*w*4, 255, ATLAS_WHITE*4);
+
+    for (int i = 0; i < spriteCount; i++) {
+        const SpriteFile *s = &sprites[i];
+        if (s->page != page) continue;
+        for (int y = 0; y < s->height; y++)
+            memcpy(image + ((size_t)(s->y + y)*w + s->x)*4, s->pixels + (size_t)y*s->width*4, (size_t)s->width*4);
+    }
+
+    char path[ATLAS_PATH_MAX];
+    snprintf(path, sizeof(path), "%s%d.png", prefix, page);
+    bool ok = stbi_write_png(path, w, h, 4, image, w*4) != 0;
+    free(image);
+    if (ok) printf("%s: %dx%d\n", path, w, h);
+    return ok;
+}
+
+static void WriteString(FILE *f, const char *s) {
+    fputc('"', f);
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') fputc('\\', f);
+        fputc(*s, f);
+    }
+    fputc('"', f);
+}
+
+static bool WriteTable(const char *path, const char *root, const char *prefix) {
+    FILE *f = fopen(path, "w");
+    if (f == NULL) return false;
+
+    fprintf(f, "// %s\n", path);
+    fprintf(f, "// Generado por atlaspack (make atlas) a partir de %s: no editar a mano\n\n", root);
+
+    fprintf(f, "#define ATLAS_PAGES %d\n", pageCount);
+    fprintf(f, "#define ATLAS_ROOT \"%s/\"\n\n", root);
+
+    fprintf(f, "static const AtlasPage atlasPages[ATLAS_PAGES] = {\n");
+    for (int p = 0; p < pageCount; p++) {
+        char page[ATLAS_PATH_MAX];
+        snprintf(page, sizeof(page), "%s%d.png", prefix, p);
+        fprintf(f, "    { ");
+        WriteString(f, page);
+        fprintf(f, ", %d, %d, { 1, 1, %d, %d } },\n", pages[p].width, pages[p].height, ATLAS_WHITE - 2, ATLAS_WHITE - 2);
+    }
+    fprintf(f, "};\n\n");
+
+    fprintf(f, "#define ATLAS_ENTRIES %d\n", spriteCount);
+    fprintf(f, "static const AtlasEntry atlasEntries[ATLAS_ENTRIES] = {\n");
+    for (int i = 0; i < spriteCount; i++) {
+        const SpriteFile *s = &sprites[i];
+        fprintf(f, "    { ");
+        WriteString(f, s->name);
+        fprintf(f, ", %d, { %d, %d, %d, %d } },\n", s->page, s->x, s->y, s->width, s->height);
+    }
+    fprintf(f, "};\n");
+
+    return fclose(f) == 0;
+}
+
+int main(int argc, char **argv) {
+
+    if (argc < 4 || argc - 4 > ATLAS_MAX_GROUPS) {
+        fprintf(stderr, "uso: atlaspack carpeta prefijo tabla.c [grupo ...]\n"
+                        "     grupo: carpetas de primer nivel separadas por comas\n");
+        return 1;
+    }
+
+    const char *root = argv[1], *prefix = argv[2], *table = argv[3];
+    for (int g = 4; g < argc; g++) snprintf(groupFolders[groupCount++], ATLAS_PATH_MAX, "%s", argv[g]);
+
+    ScanFolder(root, "");
+    if (spriteCount == 0) {
+        fprintf(stderr, "atlaspack: no hay .png en %s\n", root);
+        return 1;
+    }
+
+    // Orden fijo: la salida no depende del orden del directorio
+    qsort(sprites, spriteCount, sizeof(SpriteFile), CompareNames);
+
+    for (int g = 0; g <= groupCount; g++) PackGroup(g);
+
+    for (int p = 0; p < pageCount; p++) {
+        if (!WritePage(p, prefix)) {
+            fprintf(stderr, "atlaspack: no se pudo escribir la página %d\n", p);
+            return 1;
+        }
+    }
+
+    if (!WriteTable(table, root, prefix)) {
+        fprintf(stderr, "atlaspack: no se pudo escribir %s\n", table);
+        return 1;
+    }
+    printf("%s: %d sprites en %d páginas\n", table, spriteCount, pageCount);
+
+    for (int i = 0; i < spriteCount; i++) stbi_image_free(sprites[i].pixels);
+    free(sprites);
+    free(pages);
+    return 0;
+}
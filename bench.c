@@ -0,0 +1,187 @@
+// bench.c
+// Pruebas de rendimiento con niveles generados de distintos tamaños
+// -----------------------------------
+// Para cada tamaño N genera un nivel con N plataformas, N enemigos y N
+// objetos (stresslevel.c), juega la entrada guionizada y mide por separado
+// cada paso del tick (los mismos de GameTick, ver RunTickSteps en
+// gameplay.c), la huella del estado (HashGameState) y el bucle de dibujo
+// del mundo (DrawWorld). Los
+// resultados se añaden a un CSV para seguir la curva de cada subsistema
+// entre versiones.
+//
+// El dibujo no abre ventana: las llamadas de raylib se sustituyen por
+// funciones que solo cuentan, así que se mide el coste de CPU del bucle
+// (consulta de lo visible, interpolación, preparar cada llamada), no la GPU.
+//
+// Uso: bench [--sizes 1000,10000,100000] [--ticks N] [--seed S]
+//            [--width W] [--out archivo.csv]
+//   --width  ancho fijo del nivel (más denso al crecer N); por defecto
+//            el ancho crece con N y la densidad se mantiene
+//
+// CSV: timestamp,size,seed,width,ticks,subsystem,ns_per_tick
+//   La fila LoadLevel_ns_total es la excepción: generar y cargar el nivel
+//   una vez, en nanosegundos totales (ticks=1)
+
+#define GAME_HEADLESS
+#include "gameplay.c"
+#include "statehash.c"          // Huella del estado por tick
+#include "playercamera.c"
+#include "stresslevel.c"        // Niveles generados
+#include "scripted.c"           // Entrada guionizada
+
+// ------------------------------
+// Dibujo simulado: raylib no se enlaza, cada llamada solo se cuenta
+// ------------------------------
+static long long drawCalls = 0;
+
+Texture2D LoadTexture(const char *fileName) { (void)fileName; return (Texture2D){ 1, 64, 64, 1, 0 }; }
+void UnloadTexture(Texture2D texture) { (void)texture; }
+void DrawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint) {
+    (void)texture; (void)source; (void)dest; (void)origin; (void)rotation; (void)tint;
+    drawCalls++;
+}
+void DrawRectangleRec(Rectangle rec, Color color) { (void)rec; (void)color; drawCalls++; }
+void DrawRectangle(int posX, int posY, int width, int height, Color color) {
+    (void)posX; (void)posY; (void)width; (void)height; (void)color;
+    drawCalls++;
+}
+void DrawCircleV(Vector2 center, float radius, Color color) { (void)center; (void)radius; (void)color; drawCalls++; }
+void DrawText(const char *text, int posX, int posY, int fontSize, Color color) {
+    (void)text; (void)posX; (void)posY; (void)fontSize; (void)color;
+    drawCalls++;
+}
+Color Fade(Color color, float alpha) { color.a = (unsigned char)(alpha*255); return color; }
+const char *TextFormat(const char *text, ...) { return text; }
+Sprite LoadSprite(const char *path) { return (Sprite){ LoadTexture(path), { 0, 0, 64, 64 }, -1 }; }
+void UnloadSprite(Sprite s) { (void)s; }
+void DrawSpritePro(Sprite s, Rectangle dest, Color tint) { (void)s; (void)dest; (void)tint; drawCalls++; }
+void DrawPlayer(const PlayerAnim *a, Vector2 pos) { (void)a; (void)pos; drawCalls++; }
+void DrawEnemyAnimation(int type, Vector2 pos, int dir, int clip, int frame) { (void)type; (void)pos; (void)dir; (void)clip; (void)frame; drawCalls++; }
+
+#include "render.c"             // Bucle de dibujo del juego
+
+#define BENCH_TICKS  20000
+#define BENCH_WARMUP 600
+#define BENCH_MAX_SIZES 16
+#define BENCH_OUT "bench_results.csv"
+
+// Columnas: los pasos del tick (TICK_*, gameplay.c), la huella y el dibujo
+enum { B_HASH = TICK_STEPS, B_DRAW, B_COUNT };
+static const char *BenchName(int b) {
+    static const char *extra[B_COUNT - TICK_STEPS] = { "HashGameState", "DrawWorld" };
+    return (b < TICK_STEPS) ? tickStepNames[b] : extra[b - TICK_STEPS];
+}
+static uint32_t benchHash = 0;      // Se usa la huella para que no se elimine el cálculo
+
+// ------------------------------
+// Un tick completo; si spent != NULL se mide cada paso
+// ------------------------------
+static void BenchTick(long long tick, long long *spent) {
+
+    InputCmd cmd = ScriptedInputPlayer(0, tick);
+    if (!ProcessTickCommands(&cmd)) return;
+
+    RunTickSteps(&cmd, spent);
+
+    long long t0 = NowNs(), t1;
+    benchHash = ChainStateHash(benchHash, HashGameState());
+    t1 = NowNs(); if (spent) spent[B_HASH] += t1 - t0;
+
+    // Un fotograma por tick, a mitad de camino entre ticks
+    t0 = NowNs();
+    Vector2 playerDrawPos = InterpolatePos(players[0].prevPos, players[0].pos, 0.5f);
+    UpdatePlayerCamera(&camera, playerDrawPos);
+    SyncPlatformTextures();
+    DrawWorld(0.5f);
+    t1 = NowNs(); if (spent) spent[B_DRAW] += t1 - t0;
+}
+
+int main(int argc, char **argv) {
+
+    int sizes[BENCH_MAX_SIZES] = { 1000, 10000, 100000 };
+    int sizeCount = 3;
+    long long ticks = BENCH_TICKS;
+    uint32_t seed = 1;
+    float width = 0;
+    const char *outPath = BENCH_OUT;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--sizes") == 0 && i + 1 < argc) {
+            sizeCount = 0;
+            for (char *s = argv[++i]; *s != '\0' && sizeCount < BENCH_MAX_SIZES; ) {
+                char *end;
+                long n = strtol(s, &end, 10);
+                if (end == s) break;
+                if (n > 0) sizes[sizeCount++] = (int)n;
+                s = (*end == ',') ? end + 1 : end;
+            }
+        }
+        else if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) ticks = atoll(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = (uint32_t)strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--width") == 0 && i + 1 < argc) width = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) outPath = argv[++i];
+        else {
+            fprintf(stderr, "uso: bench [--sizes 1000,10000,100000] [--ticks N] [--seed S] [--width W] [--out archivo.csv]\n");
+            return 1;
+        }
+    }
+    if (sizeCount == 0 || ticks <= 0) {
+        fprintf(stderr, "bench: faltan tamaños o ticks\n");
+        return 1;
+    }
+
+    // Cabecera solo si el archivo es nuevo: cada ejecución añade filas
+    FILE *probe = fopen(outPath, "r");
+    bool newFile = (probe == NULL);
+    if (probe != NULL) fclose(probe);
+
+    FILE *out = fopen(outPath, "a");
+    if (out == NULL) {
+        fprintf(stderr, "bench: no se pudo abrir %s\n", outPath);
+        return 1;
+    }
+    if (newFile) fprintf(out, "timestamp,size,seed,width,ticks,subsystem,ns_per_tick\n");
+
+    long long stamp = (long long)time(NULL);
+
+    InitPlayerAnimations();
+    InitEnemyAnimations();
+
+    for (int s = 0; s < sizeCount; s++) {
+
+        size_t size = 0;
+        long long t0 = NowNs();
+        void *image = GenerateStressLevel(seed, sizes[s], width, &size);
+        if (image == NULL || !UseGeneratedLevel(image, size)) {
+            fprintf(stderr, "bench: no se pudo generar el nivel de %d\n", sizes[s]);
+            fclose(out);
+            return 1;
+        }
+        float levelWidth = level.header->goalX;
+        ResetLevel();
+        long long loadNs = NowNs() - t0;
+
+        for (long long tick = 0; tick < BENCH_WARMUP; tick++) BenchTick(tick, NULL);
+
+        long long spent[B_COUNT] = { 0 };
+        drawCalls = 0;
+        for (long long tick = 0; tick < ticks; tick++) BenchTick(BENCH_WARMUP + tick, spent);
+
+        printf("bench: N=%d (%.0f px, %.1f MB, carga %.1f ms), %lld ticks, %.1f llamadas de dibujo/tick\n",
+               sizes[s], levelWidth, size/(1024.0*1024.0), loadNs/1e6, ticks, (double)drawCalls/ticks);
+
+        for (int b = 0; b < B_COUNT; b++) {
+            double ns = (double)spent[b]/ticks;
+            printf("  %-20s %10.1f ns/tick\n", BenchName(b), ns);
+            fprintf(out, "%lld,%d,%u,%.0f,%lld,%s,%.1f\n", stamp, sizes[s], seed, levelWidth, ticks, BenchName(b), ns);
+        }
+        // La carga no es por tick: su fila lleva el total (ver CSV arriba)
+        fprintf(out, "%lld,%d,%u,%.0f,%lld,%s,%.1f\n", stamp, sizes[s], seed, levelWidth, 1LL, "LoadLevel_ns_total", (double)loadNs);
+    }
+
+    fclose(out);
+    printf("bench: resultados añadidos a %s (huella %08x, %s)\n", outPath, (unsigned int)benchHash, STATE_HASH_NAME);
+
+    UnloadLevel();
+    return 0;
+}
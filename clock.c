@@ -0,0 +1,30 @@
+// clock.c
+// Reloj monotónico en nanosegundos (red, medidas de headless y bench)
+// -----------------------------------
+// En Windows se usa el contador de alta resolución; clock() solo da
+// milisegundos y mide tiempo de proceso, no de pared.
+
+#if defined(_WIN32)
+    // Sin windows.h (choca con raylib): solo lo necesario de la API. La
+    // unión se declara fuera del prototipo para que sea la misma que la de
+    // winsock2.h cuando netplay.c la incluye detrás.
+    union _LARGE_INTEGER;
+    __declspec(dllimport) int __stdcall QueryPerformanceCounter(union _LARGE_INTEGER *count);
+    __declspec(dllimport) int __stdcall QueryPerformanceFrequency(union _LARGE_INTEGER *frequency);
+#else
+    #include <time.h>
+#endif
+
+long long NowNs(void) {
+#if defined(_WIN32)
+    static long long freq = 0;
+    long long now;
+    if (freq == 0) QueryPerformanceFrequency((union _LARGE_INTEGER *)&freq);
+    QueryPerformanceCounter((union _LARGE_INTEGER *)&now);
+    return (long long)(now*(1000000000.0/freq));
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec*1000000000LL + ts.tv_nsec;
+#endif
+}
@@ -2,105 +2,102 @@
 // Sistema de animación independiente para enemigos
 
 #include "raylib.h"
+#include <stdio.h>
 #include <stdlib.h>
 
 // ----------------------------------------------------------------------
-// Animaciones globales del enemigo
+// Clips de cada arquetipo (enemyTypes[t].clips), compartidos por todos los
+// de su clase; el frame es de cada enemigo (ver AnimateEnemies)
 // ----------------------------------------------------------------------
-Animation enemyIdleAnim;
-Animation enemyWalkAnim;
-Animation enemyDeathAnim;
+static const char *enemyClipNames[ENEMY_CLIPS] = { "quieto", "andar", "morir" };
+
+// Nombre del clip en la base de animaciones ("rata" + "andar" -> "rata.andar")
+static const char *EnemyClipName(const EnemyArchetype *a, int clip) {
+    static char name[64];
+    snprintf(name, sizeof(name), "%s.%s", a->name, enemyClipNames[clip]);
+    return name;
+}
 
 // ----------------------------------------------------------------------
-// Cargar animaciones del enemigo
+// Datos de reproducción (sin textura, válido también sin ventana)
 // ----------------------------------------------------------------------
-void LoadEnemyAnimations() {
-
-    // -------- IDLE --------
-    enemyIdleAnim.texture = LoadTexture("resources/Sprites/Enemigos/Enemigo/Mushroom-Idle.png");
-    enemyIdleAnim.frameCount = 7;
-    enemyIdleAnim.frameSpeed = 8;
-    enemyIdleAnim.currentFrame = 0;
-    enemyIdleAnim.timer = 0;
-    enemyIdleAnim.frameWidth  = enemyIdleAnim.texture.width / enemyIdleAnim.frameCount;
-    enemyIdleAnim.frameHeight = enemyIdleAnim.texture.height;
-
-    // -------- WALK --------
-    enemyWalkAnim.texture = LoadTexture("resources/Sprites/Enemigos/Enemigo/Mushroom-Run.png");
-    enemyWalkAnim.frameCount = 8;
-    enemyWalkAnim.frameSpeed = 10;
-    enemyWalkAnim.currentFrame = 0;
-    enemyWalkAnim.timer = 0;
-    enemyWalkAnim.frameWidth  = enemyWalkAnim.texture.width / enemyWalkAnim.frameCount;
-    enemyWalkAnim.frameHeight = enemyWalkAnim.texture.height;
+void InitEnemyAnimations() {
+    for (int t = 0; t < ENEMY_TYPES; t++)
+        for (int c = 0; c < ENEMY_CLIPS; c++)
+            InitAnimClip(&enemyTypes[t].clips[c], EnemyClipName(&enemyTypes[t], c));
+}
 
-    // -------- DEATH --------
-    enemyDeathAnim.texture = LoadTexture("resources/Sprites/Enemigos/Enemigo/Mushroom-Die.png");
-    enemyDeathAnim.frameCount = 15;
-    enemyDeathAnim.frameSpeed = 8;
-    enemyDeathAnim.currentFrame = 0;
-    enemyDeathAnim.timer = 0;
-    enemyDeathAnim.frameWidth  = enemyDeathAnim.texture.width / enemyDeathAnim.frameCount;
-    enemyDeathAnim.frameHeight = enemyDeathAnim.texture.height;
+#if !defined(GAME_HEADLESS)
+// ----------------------------------------------------------------------
+// Cargar animaciones de los enemigos
+// ----------------------------------------------------------------------
+void LoadEnemyAnimations() {
+    for (int t = 0; t < ENEMY_TYPES; t++)
+        for (int c = 0; c < ENEMY_CLIPS; c++)
+            LoadAnimClip(&enemyTypes[t].clips[c], EnemyClipName(&enemyTypes[t], c));
 }
 
 // ----------------------------------------------------------------------
 // Liberar memoria
 // ----------------------------------------------------------------------
 void UnloadEnemySprites() {
-    UnloadTexture(enemyIdleAnim.texture);
-    UnloadTexture(enemyWalkAnim.texture);
-    UnloadTexture(enemyDeathAnim.texture);
+    for (int t = 0; t < ENEMY_TYPES; t++)
+        for (int c = 0; c < ENEMY_CLIPS; c++)
+            UnloadSprite(enemyTypes[t].clips[c].sheet);
 }
+#endif
 
 // ----------------------------------------------------------------------
-// Actualizar animación
+// Actualizar animaciones (las de un arquetipo de una vez)
 // ----------------------------------------------------------------------
-void UpdateEnemyAnimation(Animation *anim, float dt) {
-
-    anim->timer += dt;
-
-    if (anim->timer >= (1.0f / anim->frameSpeed)) {
-        anim->timer = 0;
-        anim->currentFrame++;
-
-        if (anim->currentFrame >= anim->frameCount)
-            anim->currentFrame = 0;
+// Cada enemigo lleva su clip, su frame y su temporizador en arrays
+// paralelos (EnemyStore). Se avanzan solo los de la lista index (los
+// despiertos de un arquetipo, o los que están muriendo): los dormidos no se
+// ven y su animación sigue donde estaba al despertar. El ritmo de cada clip
+// se elige con comparaciones en vez de leer una tabla.
+// Los clips de una sola vez (morir) se quedan en frameCount al acabar.
+void AnimateEnemies(const EnemyArchetype *a, const int *index, int count,
+                    const unsigned char *clip, int *frame, float *timer, float dt) {
+    const AnimClip *idle = &a->clips[ENEMY_CLIP_IDLE];
+    const AnimClip *walk = &a->clips[ENEMY_CLIP_WALK];
+    const AnimClip *death = &a->clips[ENEMY_CLIP_DEATH];
+    float idleStep = idle->frameTime;
+    float walkStep = walk->frameTime;
+    float deathStep = death->frameTime;
+    int idleFrames = idle->frameCount;
+    int walkFrames = walk->frameCount;
+    int deathFrames = death->frameCount;
+    int idleWrap = (idle->loop == ANIM_ONCE) ? idleFrames : 0;
+    int walkWrap = (walk->loop == ANIM_ONCE) ? walkFrames : 0;
+    int deathWrap = (death->loop == ANIM_ONCE) ? deathFrames : 0;
+
+    for (int k = 0; k < count; k++) {
+        int i = index[k];
+        int c = clip[i];
+        float step = (c == ENEMY_CLIP_DEATH) ? deathStep : (c == ENEMY_CLIP_WALK) ? walkStep : idleStep;
+        int frames = (c == ENEMY_CLIP_DEATH) ? deathFrames : (c == ENEMY_CLIP_WALK) ? walkFrames : idleFrames;
+        int wrap = (c == ENEMY_CLIP_DEATH) ? deathWrap : (c == ENEMY_CLIP_WALK) ? walkWrap : idleWrap;
+
+        float t = timer[i] + dt;
+        int advance = t >= step;
+        int f = frame[i] + advance;
+
+        timer[i] = advance ? 0.0f : t;
+        frame[i] = (f >= frames) ? wrap : f;
     }
 }
 
-// Actualizar todas
-void UpdateAllEnemyAnimations(float dt) {
-    UpdateEnemyAnimation(&enemyIdleAnim, dt);
-    UpdateEnemyAnimation(&enemyWalkAnim, dt);
-    UpdateEnemyAnimation(&enemyDeathAnim, dt);
-}
-
+#if !defined(GAME_HEADLESS)
 // ----------------------------------------------------------------------
 // Dibujo del enemigo
-// tipoAnim = 0 idle, 1 walk, 2 death
+// type = arquetipo (enemyTypes)
+// clip = ENEMY_CLIP_IDLE, ENEMY_CLIP_WALK o ENEMY_CLIP_DEATH
 // dir = 1 derecha, -1 izquierda
 // ----------------------------------------------------------------------
-void DrawEnemyAnimation(Vector2 pos, int dir, int tipoAnim) {
+void DrawEnemyAnimation(int type, Vector2 pos, int dir, int clip, int frame) {
+    const AnimClip *anim = &enemyTypes[type].clips[clip];
+    if (frame >= anim->frameCount) return;     // Muerte ya terminada
 
-    Animation * anim =
-        (tipoAnim == 0) ? &enemyIdleAnim :
-        (tipoAnim == 1) ? &enemyWalkAnim :
-                          &enemyDeathAnim;
-
-    Rectangle src = {
-        anim->frameWidth * anim->currentFrame,
-        0,
-        anim->frameWidth * dir,  // flip horizontal si dir = -1
-        anim->frameHeight
-    };
-
-    Rectangle dst = {
-        pos.x - anim->frameWidth / 2,
-        pos.y - anim->frameHeight,
-        anim->frameWidth,
-        anim->frameHeight
-    };
-
-    DrawTexturePro(anim->texture, src, dst, (Vector2){0,0}, 0, WHITE);
-}
\ No newline at end of file
+    DrawAnimFrame(anim, frame, dir < 0, pos, WHITE);    // Volteado si va a la izquierda
+}
+#endif
@@ -0,0 +1,47 @@
+// enemy_types.c
+// Arquetipos de enemigo: lo que comparten todos los de una clase
+// -----------------------------------
+// Velocidad, caja, puntos, comportamiento y clips salen de esta tabla;
+// cada enemigo solo guarda su arquetipo (EnemyStore.type). Los huecos del
+// almacén se reparten por arquetipo en rangos contiguos (ver
+// UseEnemyArena), así que las listas de vivos y despiertos quedan
+// agrupadas: se actualizan y se dibujan arquetipo a arquetipo, con las
+// constantes de cada uno fuera del bucle.
+//
+// En los niveles el arquetipo es el número de la tabla (ver levelconv.c);
+// uno desconocido se trata como seta.
+
+#include "raylib.h"
+
+// Clip de cada enemigo (EnemyStore.animClip)
+enum { ENEMY_CLIP_IDLE = 0, ENEMY_CLIP_WALK, ENEMY_CLIP_DEATH, ENEMY_CLIPS };
+
+typedef enum {
+    ENEMY_PATROL = 0,       // Camina por su tramo (patrol.c) y se gira en los bordes
+    ENEMY_FLY               // Vuela a su altura inicial, flyRange a cada lado
+} EnemyBehavior;
+
+typedef struct EnemyArchetype {
+    const char *name;       // Prefijo de sus clips en la base ("seta" -> "seta.andar")
+    float speed;            // Velocidad de patrulla
+    float halfWidth;        // Caja: medio ancho y alto, con los pies en la posición
+    float height;
+    int score;              // Puntos al matarlo
+    EnemyBehavior behavior;
+    float flyRange;         // Solo ENEMY_FLY
+    AnimClip clips[ENEMY_CLIPS];    // Por ENEMY_CLIP_* (ver InitEnemyAnimations)
+} EnemyArchetype;
+
+enum { ENEMY_MUSHROOM = 0, ENEMY_RAT, ENEMY_RAT2, ENEMY_BIRD, ENEMY_TYPES };
+
+EnemyArchetype enemyTypes[ENEMY_TYPES] = {
+    { "seta",   40, 16, 32, 100, ENEMY_PATROL },
+    { "rata",   70, 12, 20, 100, ENEMY_PATROL },
+    { "rata2",  55, 12, 22, 150, ENEMY_PATROL },
+    { "pajaro", 90, 12, 24, 200, ENEMY_FLY, 160 },
+};
+
+// Arquetipo de un número leído del nivel (desconocido = seta)
+int EnemyTypeIndex(int type) {
+    return (type >= 0 && type < ENEMY_TYPES) ? type : ENEMY_MUSHROOM;
+}
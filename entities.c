@@ -0,0 +1,457 @@
+// entities.c
+// Almacenamiento de entidades como estructura de arrays (SoA)
+// -----------------------------------
+// Cada campo (posición, velocidad, caja, dirección, activo...) vive en su
+// propio array contiguo. Los arrays crecen bajo demanda, y cada tipo
+// dinámico mantiene una lista densa "alive" con los índices vivos para que
+// los bucles de actualización solo recorran entidades vivas.
+//
+// Enemigos, objetos y disparos pueden vivir en una arena (arena.c): sus
+// arrays salen de ella, crecen copiándose dentro y no se liberan uno a uno.
+
+#include "raylib.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ----------------------------------------------------------------------
+// ESTRUCTURAS
+// ----------------------------------------------------------------------
+typedef struct PlatformStore {
+    int count;
+    int capacity;
+    Rectangle *box;
+    int *type;          // Índice de textura, PLATFORM_GROUND = suelo
+    bool borrowed;      // Los arrays son del nivel mapeado (no se liberan)
+} PlatformStore;
+
+typedef struct EnemyStore {
+    int count;
+    int capacity;
+    Arena *arena;       // De dónde salen los arrays (NULL = montón)
+    Vector2 *pos;
+    Vector2 *prevPos;   // Posición del tick anterior (interpolación)
+    Vector2 *vel;
+    Rectangle *box;
+    int *dir;           // 1 derecha, -1 izquierda
+    float *spanMin;     // Tramo caminable precalculado (ver patrol.c)
+    float *spanMax;
+    bool *active;
+    int *spawn;         // Índice en las posiciones iniciales del nivel
+    int *alive;         // Índices de enemigos activos (orden creciente)
+    int aliveCount;
+    int *awake;         // Activos cerca del jugador: los que se actualizan (subconjunto de alive)
+    int awakeCount;
+    unsigned char *animClip;    // Animación de cada enemigo (ENEMY_CLIP_*)
+    int *animFrame;
+    float *animTimer;
+    int *dying;         // Muertos que aún muestran su animación (inactivos)
+    int dyingCount;
+    unsigned char *type;        // Arquetipo de cada hueco (enemyTypes, fijo)
+    // Huecos de cada arquetipo: [typeFirst, typeFirst + typeCapacity), usados
+    // los typeCount primeros. Sin rangos (typeCapacity a 0) todos comparten
+    // el almacén y crece como siempre.
+    int typeFirst[ENEMY_TYPES];
+    int typeCapacity[ENEMY_TYPES];
+    int typeCount[ENEMY_TYPES];
+    int awakeTypeEnd[ENEMY_TYPES];  // Fin de cada arquetipo en awake (agrupado)
+    bool grouped;
+} EnemyStore;
+
+typedef struct CollectibleStore {
+    int count;
+    int capacity;
+    Arena *arena;
+    Vector2 *pos;
+    Rectangle *box;
+    bool *taken;
+    int *spawn;         // Índice en las posiciones iniciales del nivel
+    int *alive;         // Índices de objetos sin recoger (orden creciente)
+    int aliveCount;
+} CollectibleStore;
+
+typedef struct ShootStore {
+    int count;
+    int capacity;
+    Arena *arena;
+    Rectangle *rec;
+    Vector2 *prevPos;   // Posición del tick anterior (interpolación)
+    Vector2 *speed;
+    float *life;        // Segundos de vida restantes
+    int *owner;         // Jugador que disparó (se lleva los puntos)
+    bool *active;
+    int *alive;         // Índices de proyectiles activos (orden de disparo)
+    int aliveCount;
+    int *freeList;      // Pila de huecos libres (se llena al compactar)
+    int freeCount;
+} ShootStore;
+
+// ----------------------------------------------------------------------
+// Utilidades de crecimiento
+// ----------------------------------------------------------------------
+static void *GrowField(void *data, int capacity, size_t elemSize) {
+    void *p = realloc(data, (size_t)capacity*elemSize);
+    if (p == NULL) {
+        fprintf(stderr, "entities: sin memoria para %d elementos\n", capacity);
+        exit(1);
+    }
+    return p;
+}
+
+// Igual que GrowField pero en la arena del almacén si tiene
+static void *GrowStoreField(Arena *arena, void *data, int oldCapacity, int capacity, size_t elemSize) {
+    if (arena == NULL) return GrowField(data, capacity, elemSize);
+    return ArenaGrow(arena, data, (size_t)oldCapacity*elemSize, (size_t)capacity*elemSize);
+}
+
+static int NextCapacity(int capacity, int needed) {
+    int cap = (capacity > 0) ? capacity : 16;
+    while (cap < needed) cap *= 2;
+    return cap;
+}
+
+// Añade un índice a una lista de vivos manteniendo el orden creciente
+static void InsertAlive(int *alive, int *aliveCount, int i) {
+    int k = (*aliveCount)++;
+    while (k > 0 && alive[k - 1] > i) { alive[k] = alive[k - 1]; k--; }
+    alive[k] = i;
+}
+
+// ----------------------------------------------------------------------
+// Plataformas
+// ----------------------------------------------------------------------
+void ReservePlatforms(PlatformStore *s, int capacity) {
+    if (capacity <= s->capacity && !s->borrowed) return;
+    capacity = NextCapacity(s->capacity, capacity);
+
+    if (s->borrowed) {
+        // Copia propia antes de modificar arrays prestados
+        Rectangle *box = GrowField(NULL, capacity, sizeof(Rectangle));
+        int *type = GrowField(NULL, capacity, sizeof(int));
+        memcpy(box, s->box, s->count*sizeof(Rectangle));
+        memcpy(type, s->type, s->count*sizeof(int));
+        s->box = box;
+        s->type = type;
+        s->borrowed = false;
+    }
+    else {
+        s->box  = GrowField(s->box,  capacity, sizeof(Rectangle));
+        s->type = GrowField(s->type, capacity, sizeof(int));
+    }
+    s->capacity = capacity;
+}
+
+// Usa arrays externos (p. ej. el nivel mapeado) sin copiarlos
+void UsePlatformArrays(PlatformStore *s, Rectangle *box, int *type, int count) {
+    if (!s->borrowed) {
+        free(s->box);
+        free(s->type);
+    }
+    s->box = box;
+    s->type = type;
+    s->count = count;
+    s->capacity = count;
+    s->borrowed = true;
+}
+
+int NewPlatform(PlatformStore *s) {
+    ReservePlatforms(s, s->count + 1);
+    return s->count++;
+}
+
+void FreePlatforms(PlatformStore *s) {
+    if (!s->borrowed) {
+        free(s->box);
+        free(s->type);
+    }
+    *s = (PlatformStore){ 0 };
+}
+
+// ----------------------------------------------------------------------
+// Enemigos
+// ----------------------------------------------------------------------
+static void ResizeEnemies(EnemyStore *s, int capacity) {
+    Arena *a = s->arena;
+    int old = s->capacity;
+
+    s->pos     = GrowStoreField(a, s->pos,     old, capacity, sizeof(Vector2));
+    s->prevPos = GrowStoreField(a, s->prevPos, old, capacity, sizeof(Vector2));
+    s->vel     = GrowStoreField(a, s->vel,     old, capacity, sizeof(Vector2));
+    s->box     = GrowStoreField(a, s->box,     old, capacity, sizeof(Rectangle));
+    s->dir     = GrowStoreField(a, s->dir,     old, capacity, sizeof(int));
+    s->spanMin = GrowStoreField(a, s->spanMin, old, capacity, sizeof(float));
+    s->spanMax = GrowStoreField(a, s->spanMax, old, capacity, sizeof(float));
+    s->active  = GrowStoreField(a, s->active,  old, capacity, sizeof(bool));
+    s->spawn   = GrowStoreField(a, s->spawn,   old, capacity, sizeof(int));
+    s->alive   = GrowStoreField(a, s->alive,   old, capacity, sizeof(int));
+    s->awake   = GrowStoreField(a, s->awake,   old, capacity, sizeof(int));
+    s->animClip  = GrowStoreField(a, s->animClip,  old, capacity, sizeof(unsigned char));
+    s->animFrame = GrowStoreField(a, s->animFrame, old, capacity, sizeof(int));
+    s->animTimer = GrowStoreField(a, s->animTimer, old, capacity, sizeof(float));
+    s->dying     = GrowStoreField(a, s->dying,     old, capacity, sizeof(int));
+    s->type      = GrowStoreField(a, s->type,      old, capacity, sizeof(unsigned char));
+    s->capacity = capacity;
+}
+
+void ReserveEnemies(EnemyStore *s, int capacity) {
+    if (capacity <= s->capacity) return;
+    ResizeEnemies(s, NextCapacity(s->capacity, capacity));
+}
+
+// Reserva un enemigo (activo) del arquetipo type y lo añade a la lista de
+// vivos (dormido hasta que se reparta la lista de despiertos).
+// Reutiliza huecos de enemigos muertos o descargados antes de crecer; con
+// rangos por arquetipo solo busca y crece dentro del suyo.
+int NewEnemy(EnemyStore *s, int type) {
+    int first = s->grouped ? s->typeFirst[type] : 0;
+    int used = s->grouped ? s->typeCount[type] : s->count;
+    int i = -1;
+
+    if (s->aliveCount < s->count) {
+        for (int k = first; k < first + used; k++) {
+            if (!s->active[k]) { i = k; break; }
+        }
+    }
+
+    if (i < 0 && s->grouped) {
+        if (used == s->typeCapacity[type]) {
+            fprintf(stderr, "entities: sin huecos para el arquetipo %d (%d)\n", type, used);
+            exit(1);
+        }
+        i = first + s->typeCount[type]++;
+        if (i >= s->count) s->count = i + 1;
+    }
+    else if (i < 0) {
+        ReserveEnemies(s, s->count + 1);
+        i = s->count++;
+    }
+
+    // Un hueco que aún mostraba una muerte deja de hacerlo
+    for (int k = 0; k < s->dyingCount; k++) {
+        if (s->dying[k] == i) { s->dying[k] = s->dying[--s->dyingCount]; break; }
+    }
+
+    s->type[i] = (unsigned char)type;
+    s->active[i] = true;
+    InsertAlive(s->alive, &s->aliveCount, i);
+    return i;
+}
+
+// Fin de cada arquetipo en la lista de despiertos (ordenada por hueco, así
+// que con rangos queda agrupada por arquetipo)
+void SplitAwakeByType(EnemyStore *s) {
+    int n = 0;
+    for (int t = 0; t < ENEMY_TYPES; t++) {
+        while (n < s->awakeCount && s->type[s->awake[n]] == t) n++;
+        s->awakeTypeEnd[t] = n;
+    }
+}
+
+// Quita de las listas de vivos y despiertos los enemigos desactivados (conserva el orden)
+void CompactEnemies(EnemyStore *s) {
+    int n = 0;
+    for (int k = 0; k < s->aliveCount; k++)
+        if (s->active[s->alive[k]]) s->alive[n++] = s->alive[k];
+    s->aliveCount = n;
+
+    n = 0;
+    for (int k = 0; k < s->awakeCount; k++)
+        if (s->active[s->awake[k]]) s->awake[n++] = s->awake[k];
+    s->awakeCount = n;
+    SplitAwakeByType(s);
+}
+
+void FreeEnemies(EnemyStore *s) {
+    if (s->arena != NULL) {
+        *s = (EnemyStore){ 0 };
+        return;
+    }
+    free(s->pos);
+    free(s->prevPos);
+    free(s->vel);
+    free(s->box);
+    free(s->dir);
+    free(s->spanMin);
+    free(s->spanMax);
+    free(s->active);
+    free(s->spawn);
+    free(s->alive);
+    free(s->awake);
+    free(s->animClip);
+    free(s->animFrame);
+    free(s->animTimer);
+    free(s->dying);
+    free(s->type);
+    *s = (EnemyStore){ 0 };
+}
+
+// Vacía el almacén y lo pasa a la arena con un rango de typeCapacity[t]
+// huecos por arquetipo, uno detrás de otro (no crece). Los huecos empiezan
+// inactivos y a cero: entre rangos puede quedar alguno sin usar.
+void UseEnemyArena(EnemyStore *s, Arena *a, const int typeCapacity[ENEMY_TYPES]) {
+    FreeEnemies(s);
+    s->arena = a;
+    s->grouped = true;
+
+    int capacity = 0;
+    for (int t = 0; t < ENEMY_TYPES; t++) {
+        s->typeFirst[t] = capacity;
+        s->typeCapacity[t] = typeCapacity[t];
+        capacity += typeCapacity[t];
+    }
+    if (capacity == 0) return;
+
+    ResizeEnemies(s, capacity);
+    memset(s->pos,       0, capacity*sizeof(Vector2));
+    memset(s->prevPos,   0, capacity*sizeof(Vector2));
+    memset(s->vel,       0, capacity*sizeof(Vector2));
+    memset(s->box,       0, capacity*sizeof(Rectangle));
+    memset(s->dir,       0, capacity*sizeof(int));
+    memset(s->spanMin,   0, capacity*sizeof(float));
+    memset(s->spanMax,   0, capacity*sizeof(float));
+    memset(s->active,    0, capacity*sizeof(bool));
+    memset(s->spawn,     0, capacity*sizeof(int));
+    memset(s->animClip,  0, capacity*sizeof(unsigned char));
+    memset(s->animFrame, 0, capacity*sizeof(int));
+    memset(s->animTimer, 0, capacity*sizeof(float));
+    for (int t = 0; t < ENEMY_TYPES; t++)
+        memset(s->type + s->typeFirst[t], t, typeCapacity[t]);
+}
+
+// ----------------------------------------------------------------------
+// Coleccionables
+// ----------------------------------------------------------------------
+static void ResizeCollectibles(CollectibleStore *s, int capacity) {
+    Arena *a = s->arena;
+    int old = s->capacity;
+
+    s->pos   = GrowStoreField(a, s->pos,   old, capacity, sizeof(Vector2));
+    s->box   = GrowStoreField(a, s->box,   old, capacity, sizeof(Rectangle));
+    s->taken = GrowStoreField(a, s->taken, old, capacity, sizeof(bool));
+    s->spawn = GrowStoreField(a, s->spawn, old, capacity, sizeof(int));
+    s->alive = GrowStoreField(a, s->alive, old, capacity, sizeof(int));
+    s->capacity = capacity;
+}
+
+void ReserveCollectibles(CollectibleStore *s, int capacity) {
+    if (capacity <= s->capacity) return;
+    ResizeCollectibles(s, NextCapacity(s->capacity, capacity));
+}
+
+// Igual que NewEnemy: reutiliza huecos de objetos recogidos o descargados
+int NewCollectible(CollectibleStore *s) {
+    int i = -1;
+
+    if (s->aliveCount < s->count) {
+        for (int k = 0; k < s->count; k++) {
+            if (s->taken[k]) { i = k; break; }
+        }
+    }
+
+    if (i < 0) {
+        ReserveCollectibles(s, s->count + 1);
+        i = s->count++;
+    }
+
+    s->taken[i] = false;
+    InsertAlive(s->alive, &s->aliveCount, i);
+    return i;
+}
+
+void CompactCollectibles(CollectibleStore *s) {
+    int n = 0;
+    for (int k = 0; k < s->aliveCount; k++)
+        if (!s->taken[s->alive[k]]) s->alive[n++] = s->alive[k];
+    s->aliveCount = n;
+}
+
+void FreeCollectibles(CollectibleStore *s) {
+    if (s->arena != NULL) {
+        *s = (CollectibleStore){ 0 };
+        return;
+    }
+    free(s->pos);
+    free(s->box);
+    free(s->taken);
+    free(s->spawn);
+    free(s->alive);
+    *s = (CollectibleStore){ 0 };
+}
+
+void UseCollectibleArena(CollectibleStore *s, Arena *a, int capacity) {
+    FreeCollectibles(s);
+    s->arena = a;
+    if (capacity > 0) ResizeCollectibles(s, capacity);
+}
+
+// ----------------------------------------------------------------------
+// Proyectiles
+// ----------------------------------------------------------------------
+static void ResizeShoots(ShootStore *s, int capacity) {
+    Arena *a = s->arena;
+    int old = s->capacity;
+
+    s->rec     = GrowStoreField(a, s->rec,     old, capacity, sizeof(Rectangle));
+    s->prevPos = GrowStoreField(a, s->prevPos, old, capacity, sizeof(Vector2));
+    s->speed   = GrowStoreField(a, s->speed,   old, capacity, sizeof(Vector2));
+    s->life    = GrowStoreField(a, s->life,    old, capacity, sizeof(float));
+    s->owner   = GrowStoreField(a, s->owner,   old, capacity, sizeof(int));
+    s->active  = GrowStoreField(a, s->active,  old, capacity, sizeof(bool));
+    s->alive   = GrowStoreField(a, s->alive,   old, capacity, sizeof(int));
+    s->freeList = GrowStoreField(a, s->freeList, old, capacity, sizeof(int));
+    s->capacity = capacity;
+}
+
+void ReserveShoots(ShootStore *s, int capacity) {
+    if (capacity <= s->capacity) return;
+    ResizeShoots(s, NextCapacity(s->capacity, capacity));
+}
+
+// O(1): saca un hueco de la lista libre o crece si está vacía
+int NewShoot(ShootStore *s) {
+    int i;
+
+    if (s->freeCount > 0) i = s->freeList[--s->freeCount];
+    else {
+        ReserveShoots(s, s->count + 1);
+        i = s->count++;
+    }
+
+    s->active[i] = true;
+    s->alive[s->aliveCount++] = i;
+    return i;
+}
+
+// Los proyectiles desactivados salen de la lista de vivos y sus huecos
+// vuelven a la lista libre (no antes: así un hueco nunca está dos veces)
+void CompactShoots(ShootStore *s) {
+    int n = 0;
+    for (int k = 0; k < s->aliveCount; k++) {
+        int i = s->alive[k];
+        if (s->active[i]) s->alive[n++] = i;
+        else s->freeList[s->freeCount++] = i;
+    }
+    s->aliveCount = n;
+}
+
+void FreeShoots(ShootStore *s) {
+    if (s->arena != NULL) {
+        *s = (ShootStore){ 0 };
+        return;
+    }
+    free(s->rec);
+    free(s->prevPos);
+    free(s->speed);
+    free(s->life);
+    free(s->owner);
+    free(s->active);
+    free(s->alive);
+    free(s->freeList);
+    *s = (ShootStore){ 0 };
+}
+
+void UseShootArena(ShootStore *s, Arena *a, int capacity) {
+    FreeShoots(s);
+    s->arena = a;
+    if (capacity > 0) ResizeShoots(s, capacity);
+}
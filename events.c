@@ -0,0 +1,101 @@
+// events.c
+// Cola de eventos de la partida (anillo de tamaño fijo)
+// -----------------------------------
+// Los bucles de actualización no tocan puntuaciones, vidas ni otras
+// entidades: resuelven su colisión y anotan lo que pasó (un enemigo muerto,
+// un jugador herido, un objeto recogido, un disparo). Al final del tick
+// ApplyGameEvents (gameplay.c) aplica cada evento en el orden en que se
+// produjo. El disparo es la excepción: entra en su almacén al momento (para
+// avanzar ya en ese tick) y su evento solo avisa.
+//
+// Los eventos aplicados se quedan en el anillo hasta que se sobrescriben,
+// así el sonido, el marcador o las partículas pueden leerlos después de
+// cada tick con su propio GameEventReader, de una vez y sin esperar a
+// nadie. Un lector que se queda más de GAME_EVENT_CAPACITY eventos atrás
+// pierde los más viejos (se cuentan en lost).
+//
+// Entre ticks no quedan eventos sin aplicar, así que las instantáneas
+// (snapshot.c) no necesitan guardar la cola.
+
+#include "raylib.h"
+#include <stdbool.h>
+
+// Potencia de 2. Tiene que caber todo lo de un tick: si no, la partida
+// para con un error (EmitGameEvent)
+#define GAME_EVENT_CAPACITY 4096
+
+typedef enum GameEventType {
+    EVENT_ENEMY_KILLED = 0,
+    EVENT_PLAYER_HIT,
+    EVENT_COLLECTIBLE_TAKEN,
+    EVENT_SHOT_FIRED,
+    GAME_EVENT_TYPES
+} GameEventType;
+
+// Causas de EVENT_ENEMY_KILLED y EVENT_PLAYER_HIT
+enum { KILL_STOMP = 0, KILL_SHOT };
+enum { HIT_ENEMY = 0, HIT_FALL };
+
+typedef struct GameEvent {
+    unsigned char type;             // GameEventType
+    unsigned char player;           // Jugador que lo causa o lo sufre
+    union {
+        struct { int enemy; int cause; Vector2 pos; } enemyKilled;
+        struct { int cause; Vector2 pos; } playerHit;          // pos: dónde estaba
+        struct { int collectible; Vector2 pos; } collectibleTaken;
+        struct { Rectangle rec; Vector2 speed; } shotFired;
+    } as;
+} GameEvent;
+
+typedef struct GameEventQueue {
+    GameEvent events[GAME_EVENT_CAPACITY];
+    unsigned int tail;              // Eventos escritos desde el principio
+    unsigned int applied;           // De ellos, ya aplicados a la partida
+} GameEventQueue;
+
+typedef struct GameEventReader {
+    unsigned int next;              // Siguiente evento por leer
+    unsigned int lost;              // Sobrescritos antes de leerlos
+} GameEventReader;
+
+// ------------------------------
+// Añadir al final. false si la cola está llena de eventos sin aplicar.
+// ------------------------------
+bool PushGameEvent(GameEventQueue *q, GameEvent e) {
+    if (q->tail - q->applied >= GAME_EVENT_CAPACITY) return false;
+    q->events[q->tail & (GAME_EVENT_CAPACITY - 1)] = e;
+    q->tail++;
+    return true;
+}
+
+// ------------------------------
+// Siguiente evento sin aplicar (para ApplyGameEvents)
+// ------------------------------
+bool PopGameEvent(GameEventQueue *q, GameEvent *e) {
+    if (q->applied == q->tail) return false;
+    *e = q->events[q->applied & (GAME_EVENT_CAPACITY - 1)];
+    q->applied++;
+    return true;
+}
+
+// ------------------------------
+// Lectores: ven solo eventos ya aplicados
+// ------------------------------
+
+// Empieza a leer a partir de ahora (descarta lo anterior)
+void InitGameEventReader(const GameEventQueue *q, GameEventReader *r) {
+    r->next = q->applied;
+    r->lost = 0;
+}
+
+bool ReadGameEvent(const GameEventQueue *q, GameEventReader *r, GameEvent *e) {
+    if (q->tail - r->next > GAME_EVENT_CAPACITY) {
+        unsigned int oldest = q->tail - GAME_EVENT_CAPACITY;
+        r->lost += oldest - r->next;
+        r->next = oldest;
+    }
+    if (r->next == q->applied) return false;
+    *e = q->events[r->next & (GAME_EVENT_CAPACITY - 1)];
+    r->next++;
+    return true;
+}
@@ -0,0 +1,1417 @@
+// gameplay.c
+// Lógica del juego: jugador, enemigos, objetos, disparos y nivel.
+// -----------------------------------
+// No dibuja ni lee la entrada: recibe un InputCmd por tick, así se
+// puede ejecutar igual en el juego (main.c) y sin ventana (headless.c),
+// y grabar/reproducir partidas exactas (replay.c).
+
+#include "raylib.h"
+
+// ------------------------------
+// INCLUSIÓN DE MÓDULOS .C
+// ------------------------------
+#include "atlas.c"              // Sprites empaquetados en atlas
+#include "animdb.c"             // Base de animaciones cocinada
+#include "animation.c"          // Animación del jugador
+#include "enemy_types.c"        // Arquetipos de enemigo
+#include "enemy_sprites.c"      // Animación independiente de enemigos
+#include "spatialhash.c"        // Fase amplia de colisiones
+#include "arena.c"              // Memoria por nivel
+#include "clock.c"              // Reloj monotónico
+#include "entities.c"           // Entidades en estructura de arrays
+#include "events.c"             // Cola de eventos de la partida
+#include "statemix.c"           // Huella incremental del estado
+#include "level.c"              // Niveles binarios mapeados en memoria
+#include "patrol.c"             // Tramos caminables de los enemigos
+#include "tilemap.c"            // Casillas con solidez en mapa de bits
+#include "sweep.c"              // Colisiones por barrido
+#include "jobs.c"               // Hilos de trabajo
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <limits.h>
+
+#define SCREEN_WIDTH 1024
+#define SCREEN_HEIGHT 576
+#define CAMERA_ZOOM 1.5f
+
+// Jugadores simultáneos (cooperativo, ver netplay.c)
+#define MAX_PLAYERS 2
+
+// Capacidad inicial de cada tipo de entidad (crecen bajo demanda)
+#define NUM_SHOOTS 50
+
+// Nivel por defecto (generado desde resources/Levels/nivel1.txt con levelconv)
+#ifndef LEVEL_PATH
+#define LEVEL_PATH "resources/Levels/nivel1.lvl"
+#endif
+#define PLATFORM_GROUND 4       // Tipo de plataforma que se dibuja como suelo
+#define PLATFORM_TYPES 11       // Texturas de plataforma (tipos 0..10)
+
+// Carga por trozos: alrededor de los jugadores (la cámara sigue al local) se
+// mantienen cargados CHUNKS_BEHIND trozos detrás y CHUNKS_AHEAD delante. Un trozo solo
+// se descarga al quedar un trozo más allá de esa ventana (histéresis).
+#define CHUNKS_BEHIND 1
+#define CHUNKS_AHEAD 2
+
+// Actualización de enemigos en paralelo: máximo de hilos (además del
+// principal, nunca más que núcleos libres) y mínimo de enemigos vivos para
+// repartir; con menos, despertar los hilos cuesta más que actualizar.
+// -DENEMY_THREADS=0 lo desactiva.
+#ifndef ENEMY_THREADS
+#define ENEMY_THREADS 3
+#endif
+// Nivel de detalle de la simulación: solo se actualizan los enemigos a
+// menos de ACTIVATION_RADIUS de algún jugador (más que media vista, así nunca
+// se ve uno dormido). El resto duerme sin coste. Los conjuntos se rehacen al
+// cruzar el jugador una franja de ACTIVATION_STEP o al cargar trozos.
+#define ACTIVATION_RADIUS 768.0f
+#define ACTIVATION_STEP 128.0f
+
+#ifndef ENEMY_PARALLEL_MIN
+#define ENEMY_PARALLEL_MIN 512
+#endif
+
+// Simulación a paso fijo: la lógica avanza siempre SIM_HZ veces por segundo,
+// sin importar los FPS de dibujo. Se puede cambiar al compilar (-DSIM_HZ=60).
+#ifndef SIM_HZ
+#define SIM_HZ 120
+#endif
+#define SIM_DT (1.0f/SIM_HZ)
+
+// ------------------------------
+// Estructuras de datos
+// ------------------------------
+typedef struct Player {
+    Vector2 pos;
+    Vector2 prevPos;    // Posición del tick anterior (interpolación)
+    Vector2 vel;
+    Rectangle box;
+    bool onGround;
+    int lives;
+    int score;
+    PlayerAnim anim;    // Estado y frame de su animación (ver animation.c)
+} Player;
+
+// Comando de entrada de un tick (2 bytes): lo único que lee la simulación.
+// Cada tick recibe uno por jugador.
+typedef struct InputCmd {
+    signed char move;       // Eje horizontal: -127 izquierda .. 127 derecha
+    unsigned char buttons;  // Pulsaciones de este tick (INPUT_*)
+} InputCmd;
+
+#define INPUT_JUMP   0x01
+#define INPUT_SHOOT  0x02
+#define INPUT_PAUSE  0x04
+#define INPUT_RESET  0x08
+
+// Disparos, plataformas, enemigos y coleccionables: ver entities.c
+
+// ------------------------------
+// Variables Globales
+// ------------------------------
+static Player players[MAX_PLAYERS];
+static int playerCount = 1;
+static int localPlayer = 0;     // Jugador que sigue la cámara en esta máquina (solo dibujo)
+static ShootStore shoot = { 0 };
+static PlatformStore platforms = { 0 };
+static EnemyStore enemies = { 0 };
+static CollectibleStore collectibles = { 0 };
+static int shootRate = 0;
+
+// Muertes, golpes, objetos recogidos y disparos del tick (ver events.c)
+static GameEventQueue gameEvents = { 0 };
+
+// Sumas de la huella de cada conjunto de entidades (ver statemix.c)
+static StateMix stateMix = { 0 };
+
+static Camera2D camera;
+
+// Fase amplia: solo contiene lo de los trozos cargados (StreamLevel);
+// los enemigos además se mueven de celda al desplazarse
+static SpatialHash platformGrid;
+static SpatialHash enemyGrid;
+static SpatialHash collectibleGrid;
+static bool gridsReady = false;
+
+// Nivel actual: arrays dentro del archivo mapeado (o el nivel de respaldo)
+static LevelData level = { .stamp = -1 };
+static const char *levelPath = LEVEL_PATH;  // NULL: nivel generado en memoria
+static Vector2 levelSpawn;
+static float levelGoalX;
+static WalkSpan *enemySpans = NULL;     // Uno por enemigo del nivel (se calcula al cargar)
+static int levelEnemyTypes[ENEMY_TYPES];    // Enemigos del nivel por arquetipo (huecos de cada rango)
+
+// Memoria del nivel (arena.c): primero lo que dura todo el nivel, después
+// de levelArenaRun los almacenes de la partida. Reiniciar vuelve a la marca;
+// cambiar de nivel vacía la arena.
+static Arena levelArena = { 0 };
+static size_t levelArenaRun = 0;
+
+// Casillas del nivel (vacío si no tiene): siempre cargadas enteras, se
+// consultan junto a las plataformas
+static TileMap tileMap = { 0 };
+static bool tileTypeUsed[PLATFORM_TYPES];   // Texturas que usan las casillas
+
+// Estado de cada posición inicial de enemigo/objeto del nivel
+enum { SPAWN_WAITING = 0, SPAWN_ACTIVE, SPAWN_GONE };
+
+// Trozos cargados y referencias que mantienen
+typedef struct LevelStream {
+    int first, last;                // Trozos cargados [first, last] (vacío si first > last)
+    unsigned char *platformRefs;    // Trozos cargados que contienen cada plataforma
+    unsigned char *enemyState;      // SPAWN_* de cada enemigo del nivel
+    unsigned char *collectibleState;// SPAWN_* de cada objeto del nivel
+    int typeRefs[PLATFORM_TYPES];   // Plataformas cargadas por tipo (texturas en uso)
+} LevelStream;
+
+static LevelStream stream = { 0, -1 };
+
+// Franjas del jugador más a la izquierda y más a la derecha en la última
+// activación (INT_MIN = rehacer)
+static int activationCell = INT_MIN;
+static int activationCellMax = INT_MIN;
+
+// Eventos de los enemigos hacia el jugador. Los trabajos de UpdateEnemies
+// no tocan al jugador: anotan el contacto en su búfer y después se aplican
+// en orden (trabajo 0, 1...), el mismo orden que un recorrido en serie.
+enum { ENEMY_EVENT_TOUCH = 0 };     // Contacto: pisotón o daño según el jugador
+
+typedef struct EnemyEvent {
+    int type;
+    int awake;                      // Posición en enemies.awake
+} EnemyEvent;
+
+typedef struct EnemyEventBuffer {
+    EnemyEvent *events;
+    int count;
+    int capacity;
+    uint32_t mixDelta;              // Cambio de stateMix.enemies de sus enemigos
+} EnemyEventBuffer;
+
+#define ENEMY_JOBS (ENEMY_THREADS + 1)
+static EnemyEventBuffer enemyEvents[ENEMY_JOBS];
+
+// Pasos del tick (RunTickSteps), con el nombre de la función de cada uno
+enum { TICK_PREV_STATE = 0, TICK_PLAYERS, TICK_ENEMIES, TICK_COLLECTIBLES, TICK_SHOOTS,
+       TICK_GOAL, TICK_EVENTS, TICK_STREAM, TICK_ACTIVATION, TICK_STEPS };
+static const char *tickStepNames[TICK_STEPS] = {
+    "SavePrevState", "UpdatePlayer", "UpdateEnemies", "UpdateCollectibles", "UpdateShoots",
+    "UpdateGoal", "ApplyGameEvents", "StreamLevel", "UpdateActivation"
+};
+
+static bool gameOver = false;
+static bool victory = false;
+static bool pauseGame = false;
+
+const float GRAVITY = 1200.0f;
+const float MOVE_SPEED = 240.0f;
+const float JUMP_SPEED = 520.0f;
+const float SHOOT_SPEED = 800.0f;
+const float SHOOT_LIFETIME = 1.5f;      // Segundos antes de desaparecer
+
+
+// ------------------------------
+// Prototipos
+// ------------------------------
+Rectangle GetPlayerBox(Player *p);
+bool CheckCollisionRectangles(Rectangle a, Rectangle b);
+int AddEnemy(int type, float x, float y);
+int AddCollectible(float x, float y);
+void InitShoots(void);
+bool LoadLevel(const char *path);
+bool UseGeneratedLevel(void *image, size_t size);
+void StreamLevel(float minX, float maxX);
+void UpdateActivation(float minX, float maxX);
+void SetPlayerCount(int count);
+void ResetLevel(void);
+void UnloadLevel(void);
+
+void PlayersSpanX(float *minX, float *maxX);
+void MovePlayerAxis(Player *pl, int axis, float delta);
+void UpdatePlayer(int p, const InputCmd *cmd, float dt);
+void UpdatePlayers(const InputCmd *cmds, float dt);
+void UpdateEnemies(float dt);
+void UpdateCollectibles(void);
+void UpdateShoots(float dt);
+void SavePrevState(void);
+void UpdateGoal(void);
+void ApplyGameEvents(void);
+bool ProcessTickCommands(const InputCmd *cmds);
+void RunTickSteps(const InputCmd *cmds, long long *spent);
+void GameTick(const InputCmd *cmds);
+
+
+// ------------------------------
+// Utilidades
+// ------------------------------
+
+// Anotar un evento. La cola solo se aplica al final del tick: si un tick
+// produce más de GAME_EVENT_CAPACITY eventos el anillo está mal dimensionado.
+static void EmitGameEvent(GameEvent e) {
+    if (!PushGameEvent(&gameEvents, e)) {
+        fprintf(stderr, "Error: mas de %d eventos en un tick (GAME_EVENT_CAPACITY)\n", GAME_EVENT_CAPACITY);
+        exit(1);
+    }
+}
+
+// ------------------------------
+// Huella incremental (statemix.c): cada escritura que cambia lo que aporta
+// una entidad corrige la suma de su conjunto. MIX_IN al entrar en el
+// conjunto, MIX_OUT al salir (con los mismos campos que al entrar).
+// ------------------------------
+#define MIX_IN  1u
+#define MIX_OUT 0xFFFFFFFFu         // -1 módulo 2^32
+
+#if STATE_HASH_ALGO != 0
+static uint32_t EnemyMix(int i) {
+    uint32_t l = MixBits(enemies.pos[i].x)*MIX_W_X + MixBits(enemies.pos[i].y)*MIX_W_Y +
+                 (uint32_t)enemies.dir[i]*MIX_W_DIR +
+                 MixBits(enemies.spanMin[i])*MIX_W_MIN + MixBits(enemies.spanMax[i])*MIX_W_MAX +
+                 (uint32_t)enemies.spawn[i]*MIX_W_SPAWN;
+    return MixKey((uint32_t)i, MIX_SALT_ENEMY)*l;
+}
+
+static uint32_t CollectibleMix(int i) {
+    uint32_t l = MixBits(collectibles.pos[i].x)*MIX_W_X + MixBits(collectibles.pos[i].y)*MIX_W_Y +
+                 (uint32_t)collectibles.spawn[i]*MIX_W_SPAWN;
+    return MixKey((uint32_t)i, MIX_SALT_COLLECTIBLE)*l;
+}
+
+static uint32_t ShootMix(int i) {
+    uint32_t l = MixBits(shoot.rec[i].x)*MIX_W_X + MixBits(shoot.rec[i].y)*MIX_W_Y +
+                 MixBits(shoot.life[i])*MIX_W_LIFE + (uint32_t)shoot.owner[i]*MIX_W_OWNER;
+    return MixKey((uint32_t)i, MIX_SALT_SHOOT)*l;
+}
+#endif
+
+static void MixEnemy(int i, uint32_t sign) {
+#if STATE_HASH_ALGO != 0
+    stateMix.enemies += sign*EnemyMix(i);
+#else
+    (void)i; (void)sign;
+#endif
+}
+
+static void MixDying(int i, uint32_t sign) {
+#if STATE_HASH_ALGO != 0
+    stateMix.dying += sign*MixKey((uint32_t)i, MIX_SALT_DYING);
+#else
+    (void)i; (void)sign;
+#endif
+}
+
+static void MixCollectible(int i, uint32_t sign) {
+#if STATE_HASH_ALGO != 0
+    stateMix.collectibles += sign*CollectibleMix(i);
+#else
+    (void)i; (void)sign;
+#endif
+}
+
+static void MixShoot(int i, uint32_t sign) {
+#if STATE_HASH_ALGO != 0
+    stateMix.shoots += sign*ShootMix(i);
+#else
+    (void)i; (void)sign;
+#endif
+}
+
+// Estado de una posición inicial (SPAWN_*): aporta estado*clave
+static void SetEnemySpawnState(uint32_t s, unsigned char state) {
+#if STATE_HASH_ALGO != 0
+    stateMix.enemySpawns += ((uint32_t)state - stream.enemyState[s])*MixKey(s, MIX_SALT_ENEMY_SPAWN);
+#endif
+    stream.enemyState[s] = state;
+}
+
+static void SetCollectibleSpawnState(uint32_t s, unsigned char state) {
+#if STATE_HASH_ALGO != 0
+    stateMix.collectibleSpawns += ((uint32_t)state - stream.collectibleState[s])*MixKey(s, MIX_SALT_COLLECTIBLE_SPAWN);
+#endif
+    stream.collectibleState[s] = state;
+}
+
+// Disparo nuevo (desde UpdatePlayer, sin esperar a la cola)
+static void SpawnShot(const GameEvent *e) {
+    int i = NewShoot(&shoot);
+    shoot.rec[i] = e->as.shotFired.rec;
+    shoot.speed[i] = e->as.shotFired.speed;
+    shoot.life[i] = SHOOT_LIFETIME;
+    shoot.owner[i] = e->player;
+    shoot.prevPos[i] = (Vector2){ shoot.rec[i].x, shoot.rec[i].y };
+    MixShoot(i, MIX_IN);
+}
+
+Rectangle GetPlayerBox(Player *p) {
+    return (Rectangle){
+        p->pos.x - p->box.width/2,
+        p->pos.y - p->box.height,
+        p->box.width,
+        p->box.height
+    };
+}
+
+bool CheckCollisionRectangles(Rectangle a, Rectangle b) {
+    return !(a.x + a.width < b.x ||
+             a.x > b.x + b.width ||
+             a.y + a.height < b.y ||
+             a.y > b.y + b.height);
+}
+
+// Sin tramo ni posición inicial: quien lo añade los pone y lo suma a la
+// huella (MixEnemy)
+int AddEnemy(int type, float x, float y) {
+    const EnemyArchetype *a = &enemyTypes[type];
+    int dying = enemies.dyingCount;
+    int i = NewEnemy(&enemies, type);
+    if (enemies.dyingCount < dying) MixDying(i, MIX_OUT);   // Reutiliza el hueco de una muerte visible
+    enemies.pos[i] = (Vector2){x,y};
+    enemies.prevPos[i] = (Vector2){x,y};
+    enemies.vel[i] = (Vector2){a->speed,0};
+    enemies.dir[i] = -1;
+    enemies.box[i] = (Rectangle){x-a->halfWidth,y-a->height,a->halfWidth*2,a->height};
+    enemies.animClip[i] = ENEMY_CLIP_WALK;
+    enemies.animFrame[i] = 0;
+    enemies.animTimer[i] = 0;
+    SpatialHashInsert(&enemyGrid, i, enemies.box[i]);
+    return i;
+}
+
+int AddCollectible(float x, float y) {
+    int i = NewCollectible(&collectibles);
+    collectibles.pos[i] = (Vector2){x,y};
+    collectibles.box[i] = (Rectangle){x-8,y-8,16,16};
+    SpatialHashInsert(&collectibleGrid, i, collectibles.box[i]);
+    return i;
+}
+
+void InitShoots() {
+    // Los proyectiles se crean al disparar; aquí solo se vacía el almacén
+    ReserveShoots(&shoot, NUM_SHOOTS);
+    shoot.count = 0;
+    shoot.aliveCount = 0;
+    shoot.freeCount = 0;
+    stateMix.shoots = 0;
+}
+
+
+// ------------------------------
+// Nivel de respaldo si falta el archivo .lvl (mismo contenido que nivel1.txt)
+// ------------------------------
+static const Rectangle defaultPlatformBox[] = {
+    //suelo
+    {10,420,900,1600}, {1620,420,600,1600}, {2620,420,600,1600}, {3920,420,600,1600},
+    //Plataformas(x,y,ancho,alto)
+    {400,340,200,24}, {700,280,160,24}, {920,220,120,24}, {1217,290,125,24}, {1520,230,120,24},
+    {2020,330,120,24}, {2300,250,120,24}, {3300,350,120,24}, {3500,260,120,24}, {3700,160,120,24}
+};
+static const int32_t defaultPlatformType[] = { 4, 4, 4, 4, 0, 1, 2, 3, 5, 6, 7, 8, 9, 10 };
+
+static const Vector2 defaultEnemySpawn[] = {
+    {1620,420}, {1690,420}, {2640,420}, {2690,420}, {3920,420}, {3990,420},   // suelos 2-4
+    {780,280}, {980,220}, {1280,290}                                          // plataformas 2-4
+};
+static const Vector2 defaultCollectibleSpawn[] = { {460,300}, {730,240} };
+
+
+static void SetupLevel(void);
+static void PlaceRunStores(void);
+static int PlatformTexType(int type);
+
+// ------------------------------
+// Cargar la geometría del nivel (solo al cambiar de nivel o de archivo)
+// ------------------------------
+bool LoadLevel(const char *path) {
+
+    bool mapped = MapLevel(&level, path);
+
+    if (!mapped && level.header == NULL) {
+        // Sin archivo: se construye la misma imagen en memoria desde las tablas de respaldo
+        size_t size = 0;
+        void *image = BuildLevelImage((Vector2){ 120, 300 }, 4300, LEVEL_CHUNK_WIDTH,
+            defaultPlatformBox, defaultPlatformType, sizeof(defaultPlatformBox)/sizeof(defaultPlatformBox[0]),
+            defaultEnemySpawn, NULL, sizeof(defaultEnemySpawn)/sizeof(defaultEnemySpawn[0]),
+            defaultCollectibleSpawn, sizeof(defaultCollectibleSpawn)/sizeof(defaultCollectibleSpawn[0]), NULL, &size);
+
+        if (!UseLevelImage(&level, image, size)) return false;
+        fprintf(stderr, "level: no se pudo cargar %s, se usa el nivel de respaldo\n", path);
+    }
+    else if (!mapped) return false;
+
+    levelPath = path;
+    SetupLevel();
+    return true;
+}
+
+// ------------------------------
+// Usar un nivel construido en memoria (p. ej. GenerateStressLevel) en
+// lugar del archivo; toma la memoria de la imagen
+// ------------------------------
+bool UseGeneratedLevel(void *image, size_t size) {
+    if (!UseLevelImage(&level, image, size)) return false;
+
+    levelPath = NULL;
+    SetupLevel();
+    return true;
+}
+
+// Lo que depende de la geometría del nivel recién cargado
+static void SetupLevel(void) {
+    const LevelHeader *h = level.header;
+    levelSpawn = (Vector2){ h->spawnX, h->spawnY };
+    levelGoalX = h->goalX;
+
+    // Las plataformas se usan en el sitio, sin copiarlas; entran en la
+    // rejilla cuando se carga un trozo que las contiene
+    UsePlatformArrays(&platforms, level.platformBox, (int *)level.platformType, (int)h->platformCount);
+
+    if (levelArena.base == NULL && !InitArena(&levelArena)) {
+        fprintf(stderr, "level: no se pudo reservar la memoria del nivel\n");
+        exit(1);
+    }
+    ArenaReset(&levelArena);
+
+    stream.platformRefs = ArenaAlloc(&levelArena, h->platformCount + 1);
+    stream.enemyState = ArenaAlloc(&levelArena, h->enemyCount + 1);
+    stream.collectibleState = ArenaAlloc(&levelArena, h->collectibleCount + 1);
+
+    // Patrulla: tramo caminable de cada enemigo, una sola vez por nivel
+    enemySpans = ArenaAlloc(&levelArena, (h->enemyCount + 1)*sizeof(WalkSpan));
+
+    // Arquetipo de cada enemigo: cuántos hay de cada uno (rangos del
+    // almacén) y su medio ancho para los tramos (temporal, detrás de una
+    // marca de la arena)
+    size_t scratch = ArenaMark(&levelArena);
+    float *halfWidth = ArenaAlloc(&levelArena, (h->enemyCount + 1)*sizeof(float));
+    memset(levelEnemyTypes, 0, sizeof(levelEnemyTypes));
+    for (uint32_t s = 0; s < h->enemyCount; s++) {
+        int t = EnemyTypeIndex(level.enemyType[s]);
+        levelEnemyTypes[t]++;
+        halfWidth[s] = enemyTypes[t].halfWidth;
+    }
+
+    BuildWalkSpans(level.platformBox, (int)h->platformCount,
+                   level.enemySpawn, (int)h->enemyCount, halfWidth, &levelArena, enemySpans);
+    ArenaRewind(&levelArena, scratch);
+
+    // Casillas: el mapa de bits se construye una vez; un enemigo que aparece
+    // sobre casillas patrulla su superficie (manda sobre las plataformas)
+    UseTileMap(&tileMap, &levelArena, (int)h->tileCols, (int)h->tileRows, h->tileSize,
+               (Vector2){ h->tileOriginX, h->tileOriginY }, level.tiles);
+
+    memset(tileTypeUsed, 0, sizeof(tileTypeUsed));
+    for (size_t t = 0; level.tiles != NULL && t < (size_t)h->tileCols*h->tileRows; t++)
+        if (level.tiles[t] != 0) tileTypeUsed[PlatformTexType(level.tiles[t] - 1)] = true;
+
+    // Los voladores no buscan suelo: van y vienen a su altura inicial
+    for (uint32_t s = 0; s < h->enemyCount; s++) {
+        const EnemyArchetype *a = &enemyTypes[EnemyTypeIndex(level.enemyType[s])];
+        Vector2 p = level.enemySpawn[s];
+        if (a->behavior == ENEMY_FLY)
+            enemySpans[s] = (WalkSpan){ p.x - a->flyRange, p.x + a->flyRange, p.y };
+        else
+            TileWalkSpan(&tileMap, p, a->halfWidth, a->height, &enemySpans[s]);
+    }
+
+    levelArenaRun = ArenaMark(&levelArena);
+    PlaceRunStores();
+}
+
+// Almacenes de una partida, vacíos, detrás de lo del nivel. Enemigos y
+// objetos tienen como mucho un hueco por posición inicial (NewEnemy
+// reutiliza los huecos libres): no crecen nunca. Los enemigos, en un rango
+// por arquetipo.
+static void PlaceRunStores(void) {
+    const LevelHeader *h = level.header;
+    ArenaRewind(&levelArena, levelArenaRun);
+    UseEnemyArena(&enemies, &levelArena, levelEnemyTypes);
+    UseCollectibleArena(&collectibles, &levelArena, (int)h->collectibleCount);
+    UseShootArena(&shoot, &levelArena, NUM_SHOOTS);
+}
+
+
+// ------------------------------
+// Carga y descarga de trozos
+// ------------------------------
+static int PlatformTexType(int type) {
+    return (type >= 0 && type < PLATFORM_TYPES) ? type : 0;
+}
+
+// Plataformas: una plataforma ancha puede estar en varios trozos
+static void LoadChunkPlatforms(int c) {
+    const LevelChunk *k = &level.chunks[c];
+
+    for (uint32_t n = 0; n < k->platformCount; n++) {
+        int p = level.chunkPlatforms[k->platformFirst + n];
+        if (stream.platformRefs[p]++ == 0) {
+            SpatialHashInsert(&platformGrid, p, platforms.box[p]);
+            stream.typeRefs[PlatformTexType(platforms.type[p])]++;
+        }
+    }
+}
+
+static void UnloadChunkPlatforms(int c) {
+    const LevelChunk *k = &level.chunks[c];
+
+    for (uint32_t n = 0; n < k->platformCount; n++) {
+        int p = level.chunkPlatforms[k->platformFirst + n];
+        if (--stream.platformRefs[p] == 0) {
+            SpatialHashRemove(&platformGrid, p);
+            stream.typeRefs[PlatformTexType(platforms.type[p])]--;
+        }
+    }
+}
+
+static void LoadChunk(int c) {
+    const LevelChunk *k = &level.chunks[c];
+
+    LoadChunkPlatforms(c);
+
+    // Enemigos y objetos que siguen en el nivel (no muertos ni recogidos)
+    for (uint32_t s = k->enemyFirst; s < k->enemyFirst + k->enemyCount; s++) {
+        if (stream.enemyState[s] != SPAWN_WAITING) continue;
+        // Aparece ya apoyado en su superficie
+        int t = EnemyTypeIndex(level.enemyType[s]);
+        int i = AddEnemy(t, level.enemySpawn[s].x, enemySpans[s].y);
+        enemies.spawn[i] = (int)s;
+        enemies.spanMin[i] = enemySpans[s].minX;
+        enemies.spanMax[i] = enemySpans[s].maxX;
+        enemies.animFrame[i] = (int)(s % (uint32_t)enemyTypes[t].clips[ENEMY_CLIP_WALK].frameCount);   // Cada uno a su paso
+        MixEnemy(i, MIX_IN);
+        SetEnemySpawnState(s, SPAWN_ACTIVE);
+    }
+
+    for (uint32_t s = k->collectibleFirst; s < k->collectibleFirst + k->collectibleCount; s++) {
+        if (stream.collectibleState[s] != SPAWN_WAITING) continue;
+        int i = AddCollectible(level.collectibleSpawn[s].x, level.collectibleSpawn[s].y);
+        collectibles.spawn[i] = (int)s;
+        MixCollectible(i, MIX_IN);
+        SetCollectibleSpawnState(s, SPAWN_ACTIVE);
+    }
+}
+
+static void UnloadChunk(int c) {
+    const LevelChunk *k = &level.chunks[c];
+
+    UnloadChunkPlatforms(c);
+
+    // Los vivos se quitan y vuelven a su posición inicial al recargar el trozo
+    uint32_t e0 = k->enemyFirst, e1 = k->enemyFirst + k->enemyCount;
+    for (int n = 0; n < enemies.aliveCount; n++) {
+        int i = enemies.alive[n];
+        uint32_t s = (uint32_t)enemies.spawn[i];
+        if (s < e0 || s >= e1) continue;
+        enemies.active[i] = false;
+        MixEnemy(i, MIX_OUT);
+        SpatialHashRemove(&enemyGrid, i);
+        SetEnemySpawnState(s, SPAWN_WAITING);
+    }
+    // Los que seguían marcados como activos murieron: no vuelven
+    for (uint32_t s = e0; s < e1; s++)
+        if (stream.enemyState[s] == SPAWN_ACTIVE) SetEnemySpawnState(s, SPAWN_GONE);
+
+    uint32_t o0 = k->collectibleFirst, o1 = k->collectibleFirst + k->collectibleCount;
+    for (int n = 0; n < collectibles.aliveCount; n++) {
+        int i = collectibles.alive[n];
+        uint32_t s = (uint32_t)collectibles.spawn[i];
+        if (s < o0 || s >= o1) continue;
+        collectibles.taken[i] = true;
+        MixCollectible(i, MIX_OUT);
+        SpatialHashRemove(&collectibleGrid, i);
+        SetCollectibleSpawnState(s, SPAWN_WAITING);
+    }
+    for (uint32_t s = o0; s < o1; s++)
+        if (stream.collectibleState[s] == SPAWN_ACTIVE) SetCollectibleSpawnState(s, SPAWN_GONE);
+
+    CompactEnemies(&enemies);
+    CompactCollectibles(&collectibles);
+}
+
+// ------------------------------
+// Ajustar los trozos cargados a la ventana que cubre [minX, maxX]
+// (las X de los jugadores)
+// ------------------------------
+void StreamLevel(float minX, float maxX) {
+    int last = (int)level.header->chunkCount - 1;
+    int c0 = LevelChunkOf(level.header, minX);
+    int c1 = LevelChunkOf(level.header, maxX);
+
+    int want0 = (c0 - CHUNKS_BEHIND < 0) ? 0 : c0 - CHUNKS_BEHIND;
+    int want1 = (c1 + CHUNKS_AHEAD > last) ? last : c1 + CHUNKS_AHEAD;
+
+    int first1, last1;
+    if (stream.first > stream.last) {
+        first1 = want0;
+        last1 = want1;
+    } else {
+        // Conservar lo ya cargado dentro de la ventana con histéresis
+        first1 = (stream.first < want0 - 1) ? want0 : (stream.first > want0) ? want0 : stream.first;
+        last1 = (stream.last > want1 + 1) ? want1 : (stream.last < want1) ? want1 : stream.last;
+    }
+
+    if (first1 == stream.first && last1 == stream.last) return;
+
+    // Primero descargar (libera huecos), luego cargar
+    for (int c = stream.first; c <= stream.last; c++)
+        if (c < first1 || c > last1) UnloadChunk(c);
+
+    for (int c = first1; c <= last1; c++)
+        if (c < stream.first || c > stream.last) LoadChunk(c);
+
+    stream.first = first1;
+    stream.last = last1;
+
+    // Han entrado o salido enemigos: rehacer los despiertos
+    activationCell = INT_MIN;
+}
+
+
+// ------------------------------
+// Activación: despertar a los enemigos cercanos a [minX, maxX] (las X de
+// los jugadores) y dormir al resto.
+// Solo depende de la posición de los jugadores, así que es determinista.
+// ------------------------------
+void UpdateActivation(float minX, float maxX) {
+    int cell = (int)floorf(minX / ACTIVATION_STEP);
+    int cellMax = (int)floorf(maxX / ACTIVATION_STEP);
+    if (cell == activationCell && cellMax == activationCellMax) return;
+    activationCell = cell;
+    activationCellMax = cellMax;
+
+    enemies.awakeCount = 0;
+    for (int k = 0; k < enemies.aliveCount; k++) {
+        int i = enemies.alive[k];
+        float x = enemies.pos[i].x;
+        float d = (x < minX) ? minX - x : (x > maxX) ? x - maxX : 0.0f;
+        if (d <= ACTIVATION_RADIUS)
+            enemies.awake[enemies.awakeCount++] = i;
+    }
+    SplitAwakeByType(&enemies);
+}
+
+
+// ------------------------------
+// Número de jugadores (se aplica en el siguiente ResetLevel)
+// ------------------------------
+void SetPlayerCount(int count) {
+    playerCount = (count < 1) ? 1 : (count > MAX_PLAYERS) ? MAX_PLAYERS : count;
+    if (localPlayer >= playerCount) localPlayer = 0;
+}
+
+
+// ------------------------------
+// Reset del nivel
+// ------------------------------
+void ResetLevel() {
+
+    if (!gridsReady) {
+        InitSpatialHash(&platformGrid, GRID_CELL_SIZE);
+        InitSpatialHash(&enemyGrid, GRID_CELL_SIZE);
+        InitSpatialHash(&collectibleGrid, GRID_CELL_SIZE);
+        gridsReady = true;
+    }
+
+    // La geometría solo se vuelve a mapear si el .lvl cambió en disco
+    // (así se puede editar y reconvertir el nivel sin recompilar);
+    // un nivel generado no tiene archivo y se mantiene
+    if (level.header == NULL) LoadLevel(levelPath != NULL ? levelPath : LEVEL_PATH);
+    else if (levelPath != NULL && LevelFileChanged(&level, levelPath)) LoadLevel(levelPath);
+
+    for (int p = 0; p < playerCount; p++) {
+        players[p] = (Player){ 0 };
+        players[p].pos = levelSpawn;
+        players[p].prevPos = levelSpawn;
+        players[p].box = (Rectangle){0,0,28,64};
+        players[p].lives = 3;
+        players[p].anim = (PlayerAnim){ PLAYER_IDLE, true };
+    }
+
+    camera.target = players[localPlayer].pos;
+    camera.offset = (Vector2){SCREEN_WIDTH/2, 450};
+    camera.zoom = CAMERA_ZOOM;
+
+    // Todo descargado: enemigos y objetos vuelven a sus posiciones iniciales
+    const LevelHeader *h = level.header;
+
+    PlaceRunStores();
+
+    ClearSpatialHash(&platformGrid);
+    ClearSpatialHash(&enemyGrid);
+    ClearSpatialHash(&collectibleGrid);
+
+    memset(stream.platformRefs, 0, h->platformCount);
+    memset(stream.enemyState, SPAWN_WAITING, h->enemyCount);
+    memset(stream.collectibleState, SPAWN_WAITING, h->collectibleCount);
+    memset(stream.typeRefs, 0, sizeof(stream.typeRefs));
+    stream.first = 0;
+    stream.last = -1;
+    stateMix = (StateMix){ 0 };     // Almacenes vacíos y todo en SPAWN_WAITING
+    activationCell = activationCellMax = INT_MIN;
+
+    // Cargar los trozos alrededor del punto de inicio
+    StreamLevel(levelSpawn.x, levelSpawn.x);
+    UpdateActivation(levelSpawn.x, levelSpawn.x);
+
+    InitShoots();
+    shootRate = 0;
+
+    gameOver = false;
+    victory = false;
+    pauseGame = false;
+}
+
+
+// ------------------------------
+// Guardar el estado del tick anterior (para interpolar al dibujar)
+// ------------------------------
+void SavePrevState() {
+    for (int p = 0; p < playerCount; p++) players[p].prevPos = players[p].pos;
+
+    // Solo los despiertos: son los únicos que se mueven y se dibujan, y el
+    // coste no crece con el tamaño del nivel. Uno que se duerme se queda
+    // con la posición de su penúltimo tick; al despertar (fuera de la
+    // vista) recupera la copia en el tick siguiente.
+    for (int k = 0; k < enemies.awakeCount; k++) {
+        int i = enemies.awake[k];
+        enemies.prevPos[i] = enemies.pos[i];
+    }
+
+    for (int k=0;k<shoot.aliveCount;k++) {
+        int i = shoot.alive[k];
+        shoot.prevPos[i] = (Vector2){ shoot.rec[i].x, shoot.rec[i].y };
+    }
+}
+
+
+// ------------------------------
+// Extensión en X de los jugadores (ventana de carga y de activación)
+// ------------------------------
+void PlayersSpanX(float *minX, float *maxX) {
+    *minX = *maxX = players[0].pos.x;
+    for (int p = 1; p < playerCount; p++) {
+        *minX = fminf(*minX, players[p].pos.x);
+        *maxX = fmaxf(*maxX, players[p].pos.x);
+    }
+}
+
+
+// ------------------------------
+// Mover a un jugador en un eje sin atravesar plataformas (colisión continua).
+// Se busca el primer contacto de todo el recorrido, contra plataformas y
+// casillas: no importa lo rápido que vaya ni lo grande que sea el tick. Al
+// chocar se queda pegado a la cara tocada y pierde la velocidad en ese eje
+// (suelo, techo o pared).
+// ------------------------------
+void MovePlayerAxis(Player *pl, int axis, float delta) {
+    if (delta == 0.0f) return;
+
+    Rectangle box = GetPlayerBox(pl);
+    Vector2 move = axis ? (Vector2){ 0, delta } : (Vector2){ delta, 0 };
+
+    int nearCount;
+    const int *near = SpatialHashQuery(&platformGrid, SweptBounds(box, move), &nearCount);
+
+    bool hit = false;
+    float hitT = 1.0f;
+    float face = 0.0f;              // Coordenada de la cara que lo detiene
+    for (int k=0;k<nearCount;k++) {
+        Rectangle p = platforms.box[near[k]];
+        float t = SweepRecAxis(box, delta, axis, p);
+        if (t < hitT) {
+            hitT = t;
+            hit = true;
+            if (axis == 0) face = (delta > 0) ? p.x : p.x + p.width;
+            else face = (delta > 0) ? p.y : p.y + p.height;
+        }
+    }
+
+    float tileFace;
+    float t = SweepTilesAxis(&tileMap, box, delta, axis, &tileFace);
+    if (t < hitT) {
+        hitT = t;
+        hit = true;
+        face = tileFace;
+    }
+
+    if (!hit) {
+        if (axis) pl->pos.y += delta; else pl->pos.x += delta;
+        return;
+    }
+
+    // La posición es el centro de los pies: se coloca justo en la cara
+    if (axis == 0) {
+        pl->pos.x = (delta > 0) ? face - box.width/2 : face + box.width/2;
+        pl->vel.x = 0;
+    } else if (delta > 0) {
+        pl->pos.y = face;                            // suelo
+        pl->vel.y = 0;
+        pl->onGround = true;
+    } else {
+        pl->pos.y = face + box.height;               // techo
+        pl->vel.y = 0;
+    }
+}
+
+
+// ------------------------------
+// Actualizar un jugador. Sin vidas queda quieto en su animación de muerte.
+// ------------------------------
+void UpdatePlayer(int p, const InputCmd *cmd, float dt) {
+
+    Player *pl = &players[p];
+    PlayerAnim *anim = &pl->anim;
+
+    if (pl->lives <= 0) {
+        if (anim->state != PLAYER_DEATH) {
+            anim->state = PLAYER_DEATH;
+            ResetPlayerAnim(anim, PLAYER_DEATH);
+        }
+        if (!IsPlayerAnimFinished(anim)) UpdatePlayerAnim(anim, dt);
+        pl->vel = (Vector2){0,0};
+        return;
+    }
+
+    float move = cmd->move / 127.0f;
+
+    // MOVIMIENTO → ANIMACIÓN
+    if (move > 0) anim->facingRight = true;
+    else if (move < 0) anim->facingRight = false;
+
+    // ---------------------
+    // DEFINIR ESTADO DE ANIMACIÓN
+    // ---------------------
+    anim->state = (move != 0) ? PLAYER_WALK : PLAYER_IDLE;
+
+    if ((cmd->buttons & INPUT_JUMP) && pl->onGround) 
+    {
+        pl->vel.y = -JUMP_SPEED;
+        pl->onGround = false;
+    }
+
+
+    // Actualizar animación según estado
+    UpdatePlayerAnim(anim, dt);
+
+    pl->vel.x = move * MOVE_SPEED;
+
+      // Disparar: el proyectil entra ya en el almacén (avanza en este mismo
+      // tick); el evento solo avisa a los lectores
+    if (cmd->buttons & INPUT_SHOOT)
+    {
+        Rectangle box = GetPlayerBox(pl);
+        GameEvent e = { EVENT_SHOT_FIRED, (unsigned char)p };
+        e.as.shotFired.rec = (Rectangle){ box.x + box.width, box.y + box.height/2, 10, 5 };
+        e.as.shotFired.speed = (Vector2){ SHOOT_SPEED, 0 };
+        SpawnShot(&e);
+        EmitGameEvent(e);
+    } else shootRate = 0;
+    
+
+    // FÍSICAS: primero X y luego Y, cada eje con su barrido contra las plataformas
+    pl->vel.y += GRAVITY * dt;
+    pl->onGround = false;
+
+    MovePlayerAxis(pl, 0, pl->vel.x * dt);
+    MovePlayerAxis(pl, 1, pl->vel.y * dt);
+
+    pl->box = GetPlayerBox(pl);
+
+    // Caer al vacío (la vida y la reaparición, al aplicar el evento)
+    if (pl->pos.y > 1400) {
+        GameEvent e = { EVENT_PLAYER_HIT, (unsigned char)p };
+        e.as.playerHit.cause = HIT_FALL;
+        e.as.playerHit.pos = pl->pos;
+        EmitGameEvent(e);
+    }
+}
+
+// Todos los jugadores, en orden. La partida acaba cuando ninguno tiene vidas.
+void UpdatePlayers(const InputCmd *cmds, float dt) {
+    for (int p = 0; p < playerCount; p++) UpdatePlayer(p, &cmds[p], dt);
+
+    bool anyAlive = false;
+    for (int p = 0; p < playerCount; p++) anyAlive |= players[p].lives > 0;
+    if (!anyAlive) gameOver = true;
+}
+
+
+// ------------------------------
+// Actualizar enemigos (MOVIMIENTO + ANIMACIÓN)
+// ------------------------------
+typedef struct EnemyJobContext {
+    float dt;
+    Rectangle playerBox[MAX_PLAYERS];   // Cajas de los jugadores con vidas al empezar el tick
+    int playerCount;
+    int jobCount;
+} EnemyJobContext;
+
+static void PushEnemyEvent(EnemyEventBuffer *b, EnemyEvent e) {
+    if (b->count == b->capacity) {
+        b->capacity = (b->capacity > 0) ? b->capacity*2 : 64;
+        b->events = GrowField(b->events, b->capacity, sizeof(EnemyEvent));
+    }
+    b->events[b->count++] = e;
+}
+
+// Patrulla de los despiertos [first, last), todos del mismo arquetipo
+// (misma velocidad): avanzar hasta el borde del tramo y girar
+static void PatrolEnemies(int first, int last, float speed, const EnemyJobContext *ctx, EnemyEventBuffer *out) {
+    float dt = ctx->dt;
+    uint32_t mixDelta = 0;
+
+    for (int n = first; n < last; n++) {
+        int i = enemies.awake[n];
+        Vector2 pos = enemies.pos[i];
+        Rectangle box = enemies.box[i];
+        int dir = enemies.dir[i];
+
+        // Patrulla: avanzar hasta el borde del tramo caminable y girar
+        float nextX = pos.x + speed * dir * dt;
+
+        if ((dir < 0 && nextX <= enemies.spanMin[i]) || (dir > 0 && nextX >= enemies.spanMax[i])) {
+            dir *= -1;
+            // ajustar posición para evitar quedar 'pegado' fuera del borde
+            pos.x += speed * dir * dt;
+        } else {
+            // avanzar
+            pos.x = nextX;
+        }
+
+        // actualizar caja final
+        box.x = pos.x - box.width / 2.0f;
+        box.y = pos.y - box.height;
+#if STATE_HASH_ALGO != 0
+        // Huella: solo cambian x y la dirección
+        mixDelta += MixKey((uint32_t)i, MIX_SALT_ENEMY)*
+                    ((MixBits(pos.x) - MixBits(enemies.pos[i].x))*MIX_W_X +
+                     ((uint32_t)dir - (uint32_t)enemies.dir[i])*MIX_W_DIR);
+#endif
+        enemies.pos[i] = pos;
+        enemies.box[i] = box;
+        enemies.dir[i] = dir;
+
+        // Colisión con algún jugador: se resuelve al combinar los eventos
+        for (int p = 0; p < ctx->playerCount; p++) {
+            if (CheckCollisionRectangles(box, ctx->playerBox[p])) {
+                PushEnemyEvent(out, (EnemyEvent){ ENEMY_EVENT_TOUCH, n });
+                break;
+            }
+        }
+    }
+
+    out->mixDelta += mixDelta;
+}
+
+// Un trabajo: un tramo contiguo de la lista de despiertos, que está
+// agrupada por arquetipo; cada trozo de un arquetipo va en su bucle.
+// Solo escribe en sus enemigos y en su búfer de eventos.
+static void UpdateEnemyRange(int job, void *arg) {
+    const EnemyJobContext *ctx = arg;
+    EnemyEventBuffer *out = &enemyEvents[job];
+
+    int first = (int)((long long)enemies.awakeCount * job / ctx->jobCount);
+    int last = (int)((long long)enemies.awakeCount * (job + 1) / ctx->jobCount);
+
+    int typeStart = 0;
+    for (int t = 0; t < ENEMY_TYPES; t++) {
+        int typeEnd = enemies.awakeTypeEnd[t];
+        int n0 = (first > typeStart) ? first : typeStart;
+        int n1 = (last < typeEnd) ? last : typeEnd;
+        if (n0 < n1) PatrolEnemies(n0, n1, enemyTypes[t].speed, ctx, out);
+        typeStart = typeEnd;
+    }
+}
+
+// Contacto del enemigo i con el jugador p. Devuelve true si el jugador
+// recibió daño. Solo marca al enemigo: el rebote, los puntos, las vidas, la
+// reaparición y la rejilla cambian al aplicar los eventos.
+static bool ResolveEnemyTouch(int p, int i) {
+    const Player *pl = &players[p];
+    GameEvent e = { 0, (unsigned char)p };
+
+    if (pl->vel.y > 200.0f) {
+        // jugador salta encima -> enemigo muere
+        enemies.active[i] = false;
+
+        e.type = EVENT_ENEMY_KILLED;
+        e.as.enemyKilled.enemy = i;
+        e.as.enemyKilled.cause = KILL_STOMP;
+        e.as.enemyKilled.pos = enemies.pos[i];
+        EmitGameEvent(e);
+        return false;
+    }
+
+    // daño al jugador
+    e.type = EVENT_PLAYER_HIT;
+    e.as.playerHit.cause = HIT_ENEMY;
+    e.as.playerHit.pos = pl->pos;
+    EmitGameEvent(e);
+    return true;
+}
+
+// Contactos del enemigo i con cada jugador con vidas, en orden de jugador
+// (en serie, en orden de la lista de despiertos). Un jugador herido en este
+// tick ya va a reaparecer: no recibe más contactos (hurt, uno por jugador).
+static void ResolveEnemyContacts(int i, bool *hurt) {
+    for (int p = 0; p < playerCount && enemies.active[i]; p++) {
+        Player *pl = &players[p];
+        if (pl->lives <= 0 || hurt[p] || !CheckCollisionRectangles(enemies.box[i], GetPlayerBox(pl))) continue;
+        if (ResolveEnemyTouch(p, i)) hurt[p] = true;
+    }
+}
+
+// Animaciones de los enemigos que se ven: los despiertos, trozo a trozo de
+// cada arquetipo en la lista, y los que están muriendo. Los que terminan de
+// morir se quitan de la lista de muertes visibles.
+static void UpdateEnemyAnimations(float dt) {
+    int typeStart = 0;
+    for (int t = 0; t < ENEMY_TYPES; t++) {
+        int typeEnd = enemies.awakeTypeEnd[t];
+        AnimateEnemies(&enemyTypes[t], enemies.awake + typeStart, typeEnd - typeStart,
+                       enemies.animClip, enemies.animFrame, enemies.animTimer, dt);
+        typeStart = typeEnd;
+    }
+
+    int n = 0;
+    for (int k = 0; k < enemies.dyingCount; k++) {
+        int i = enemies.dying[k];
+        AnimateEnemies(&enemyTypes[enemies.type[i]], &i, 1,
+                       enemies.animClip, enemies.animFrame, enemies.animTimer, dt);
+        if (enemies.animFrame[i] < enemyTypes[enemies.type[i]].clips[ENEMY_CLIP_DEATH].frameCount) enemies.dying[n++] = i;
+        else MixDying(i, MIX_OUT);
+    }
+    enemies.dyingCount = n;
+}
+
+void UpdateEnemies(float dt) {
+
+    UpdateEnemyAnimations(dt); // ← animaciones
+
+    // Con pocos enemigos un solo trabajo en este hilo (mismo resultado)
+    EnemyJobContext ctx = { .dt = dt, .jobCount = 1 };
+    for (int p = 0; p < playerCount; p++)
+        if (players[p].lives > 0) ctx.playerBox[ctx.playerCount++] = GetPlayerBox(&players[p]);
+
+    if (ENEMY_THREADS > 0 && enemies.awakeCount >= ENEMY_PARALLEL_MIN) {
+        InitJobPool(ENEMY_THREADS);
+        ctx.jobCount = JobPoolWorkers() + 1;
+    }
+
+    for (int j = 0; j < ctx.jobCount; j++) {
+        enemyEvents[j].count = 0;
+        enemyEvents[j].mixDelta = 0;
+    }
+    RunJobs(UpdateEnemyRange, &ctx, ctx.jobCount);
+    for (int j = 0; j < ctx.jobCount; j++) stateMix.enemies += enemyEvents[j].mixDelta;
+
+    // La rejilla no admite escrituras concurrentes: se mueve aquí
+    for (int n = 0; n < enemies.awakeCount; n++) {
+        int i = enemies.awake[n];
+        SpatialHashUpdate(&enemyGrid, i, enemies.box[i]);
+    }
+
+    // Combinar eventos en orden. Los jugadores no se mueven hasta aplicar los
+    // eventos del tick, así que cada contacto vale tal como se anotó.
+    bool hurt[MAX_PLAYERS] = { false };
+
+    for (int j = 0; j < ctx.jobCount; j++) {
+        for (int e = 0; e < enemyEvents[j].count; e++)
+            ResolveEnemyContacts(enemies.awake[enemyEvents[j].events[e].awake], hurt);
+    }
+
+    CompactEnemies(&enemies);
+}
+
+
+
+
+// ------------------------------
+// Actualizar objetos
+// ------------------------------
+void UpdateCollectibles() {
+    for (int p = 0; p < playerCount; p++) {
+        if (players[p].lives <= 0) continue;
+        Rectangle pbox = GetPlayerBox(&players[p]);
+
+        int nearCount;
+        const int *near = SpatialHashQuery(&collectibleGrid, pbox, &nearCount);
+
+        for (int k=0;k<nearCount;k++) {
+            int i = near[k];
+            if (!collectibles.taken[i] &&
+                CheckCollisionRectangles(collectibles.box[i], pbox)) {
+                collectibles.taken[i] = true;
+
+                GameEvent e = { EVENT_COLLECTIBLE_TAKEN, (unsigned char)p };
+                e.as.collectibleTaken.collectible = i;
+                e.as.collectibleTaken.pos = collectibles.pos[i];
+                EmitGameEvent(e);
+            }
+        }
+    }
+
+    CompactCollectibles(&collectibles);
+}
+
+
+// ------------------------------
+// Disparos
+// ------------------------------
+void UpdateShoots(float dt) {
+
+    // Fuera de cámara: la cámara sigue a un jugador, así que basta con la
+    // distancia en X a cada uno (una vista entera de margen a cada lado).
+    // Se usa el zoom fijo y no la cámara: la simulación no depende del dibujo.
+    float cullDistance = SCREEN_WIDTH / CAMERA_ZOOM;
+
+    for (int n=0;n<shoot.aliveCount;n++) {
+        int i = shoot.alive[n];
+
+        Rectangle rec = shoot.rec[i];
+        Vector2 delta = { shoot.speed[i].x * dt, shoot.speed[i].y * dt };
+
+        // Barrido: se prueba todo el recorrido del tick, no solo la posición
+        // final, y gana el enemigo que se toca antes (no atraviesa a altos FPS
+        // ni a tick lento)
+        int nearCount;
+        const int *near = SpatialHashQuery(&enemyGrid, SweptBounds(rec, delta), &nearCount);
+
+        int hit = -1;
+        float hitT = 2.0f;
+        for (int k=0;k<nearCount;k++) {
+            int e = near[k];
+            float t;
+            if (enemies.active[e] && SweepRecRec(rec, delta, enemies.box[e], &t) && t < hitT) {
+                hit = e;
+                hitT = t;
+            }
+        }
+
+        // Las casillas sólidas paran el disparo (rayo desde su centro). Las
+        // plataformas no: se atraviesan, como siempre.
+        float wallT;
+        Vector2 center = { rec.x + rec.width/2, rec.y + rec.height/2 };
+        if (RaycastTiles(&tileMap, center, delta, &wallT) && wallT < hitT) {
+            MixShoot(i, MIX_OUT);
+            shoot.active[i] = false;
+            shoot.rec[i].x += delta.x * wallT;
+            shoot.rec[i].y += delta.y * wallT;
+            continue;
+        }
+
+        if (hit >= 0) {
+            enemies.active[hit] = false;
+            MixShoot(i, MIX_OUT);
+            shoot.active[i] = false;
+
+            GameEvent e = { EVENT_ENEMY_KILLED, (unsigned char)shoot.owner[i] };
+            e.as.enemyKilled.enemy = hit;
+            e.as.enemyKilled.cause = KILL_SHOT;
+            e.as.enemyKilled.pos = enemies.pos[hit];
+            EmitGameEvent(e);
+
+            // Se queda en el punto de impacto (para interpolar al dibujar)
+            shoot.rec[i].x += delta.x * hitT;
+            shoot.rec[i].y += delta.y * hitT;
+            continue;
+        }
+
+        float x = rec.x + delta.x;
+        float y = rec.y + delta.y;
+        float life = shoot.life[i] - dt;
+
+        bool inView = false;
+        for (int p = 0; p < playerCount && !inView; p++)
+            inView = fabsf(x - players[p].pos.x) <= cullDistance;
+
+        if (life <= 0.0f || !inView) {
+            MixShoot(i, MIX_OUT);
+            shoot.active[i] = false;
+        }
+#if STATE_HASH_ALGO != 0
+        else {
+            // Huella: solo cambian la posición y la vida
+            stateMix.shoots += MixKey((uint32_t)i, MIX_SALT_SHOOT)*
+                               ((MixBits(x) - MixBits(rec.x))*MIX_W_X + (MixBits(y) - MixBits(rec.y))*MIX_W_Y +
+                                (MixBits(life) - MixBits(shoot.life[i]))*MIX_W_LIFE);
+        }
+#endif
+
+        shoot.rec[i].x = x;
+        shoot.rec[i].y = y;
+        shoot.life[i] = life;
+    }
+
+    CompactShoots(&shoot);
+    CompactEnemies(&enemies);
+}
+
+
+// ------------------------------
+// Meta del nivel
+// ------------------------------
+void UpdateGoal() {
+    // WIN CONDITION: basta con que llegue un jugador
+    for (int p = 0; p < playerCount; p++)
+        if (players[p].pos.x >= levelGoalX && !victory)
+            victory = true;
+}
+
+
+// ------------------------------
+// Aplicar los eventos del tick, una vez al final y en el orden en que se
+// produjeron. Cada tipo tiene su sistema; los bucles que los generan solo
+// marcan su propia colisión (enemigo o disparo inactivo, objeto recogido).
+// ------------------------------
+static void ApplyEnemyKilled(const GameEvent *e) {
+    int i = e->as.enemyKilled.enemy;
+    SpatialHashRemove(&enemyGrid, i);
+    MixEnemy(i, MIX_OUT);
+
+    // Se queda donde murió hasta acabar su animación
+    enemies.animClip[i] = ENEMY_CLIP_DEATH;
+    enemies.animFrame[i] = 0;
+    enemies.animTimer[i] = 0;
+    enemies.dying[enemies.dyingCount++] = i;
+    MixDying(i, MIX_IN);
+
+    players[e->player].score += enemyTypes[enemies.type[i]].score;
+
+    // Pisotón: el jugador rebota
+    if (e->as.enemyKilled.cause == KILL_STOMP) players[e->player].vel.y = -JUMP_SPEED * 0.4f;
+}
+
+// Pierde una vida (varios golpes en el mismo tick no bajan de 0) y
+// reaparece quieto en el inicio del nivel
+static void ApplyPlayerHit(const GameEvent *e) {
+    Player *pl = &players[e->player];
+    if (pl->lives > 0) pl->lives--;
+
+    pl->pos = levelSpawn;
+    pl->prevPos = pl->pos;
+    if (e->as.playerHit.cause == HIT_ENEMY) pl->vel = (Vector2){0,0};
+}
+
+static void ApplyCollectibleTaken(const GameEvent *e) {
+    SpatialHashRemove(&collectibleGrid, e->as.collectibleTaken.collectible);
+    MixCollectible(e->as.collectibleTaken.collectible, MIX_OUT);
+    players[e->player].score += 50;
+}
+
+void ApplyGameEvents(void) {
+    GameEvent e;
+    while (PopGameEvent(&gameEvents, &e)) {
+        switch (e.type) {
+            case EVENT_ENEMY_KILLED:      ApplyEnemyKilled(&e); break;
+            case EVENT_PLAYER_HIT:        ApplyPlayerHit(&e); break;
+            case EVENT_COLLECTIBLE_TAKEN: ApplyCollectibleTaken(&e); break;
+            case EVENT_SHOT_FIRED:        break;    // Ya en el almacén
+        }
+    }
+}
+
+
+// ------------------------------
+// Órdenes de partida del tick (reinicio y pausa), de cualquier jugador.
+// Devuelve true si el mundo debe avanzar en este tick.
+// ------------------------------
+bool ProcessTickCommands(const InputCmd *cmds) {
+    unsigned char buttons = 0;
+    for (int p = 0; p < playerCount; p++) buttons |= cmds[p].buttons;
+
+    if (buttons & INPUT_RESET) {
+        ResetLevel();
+        return false;
+    }
+
+    if (buttons & INPUT_PAUSE) pauseGame = !pauseGame;
+
+    return !pauseGame && !gameOver && !victory;
+}
+
+
+// ------------------------------
+// Pasos de un tick, en orden. GameTick los recorre; headless.c y bench.c
+// recorren los mismos midiendo cada uno (RunTickSteps con spent).
+// ------------------------------
+static void RunTickStep(int step, const InputCmd *cmds) {
+    float minX, maxX;
+
+    switch (step) {
+        case TICK_PREV_STATE:   SavePrevState(); break;
+        case TICK_PLAYERS:      UpdatePlayers(cmds, SIM_DT); break;
+        case TICK_ENEMIES:      UpdateEnemies(SIM_DT); break;
+        case TICK_COLLECTIBLES: UpdateCollectibles(); break;
+        case TICK_SHOOTS:       UpdateShoots(SIM_DT); break;
+        case TICK_GOAL:         UpdateGoal(); break;
+        case TICK_EVENTS:       ApplyGameEvents(); break;   // Una vez, antes de cargar/descargar: las rejillas cambian
+        case TICK_STREAM:
+            PlayersSpanX(&minX, &maxX);
+            StreamLevel(minX, maxX);
+            break;
+        case TICK_ACTIVATION:
+            PlayersSpanX(&minX, &maxX);
+            UpdateActivation(minX, maxX);
+            break;
+    }
+}
+
+// Todos los pasos (tras ProcessTickCommands). Si spent != NULL se suma a
+// spent[paso] lo que tarda cada uno, en nanosegundos.
+void RunTickSteps(const InputCmd *cmds, long long *spent) {
+    if (spent == NULL) {
+        for (int step = 0; step < TICK_STEPS; step++) RunTickStep(step, cmds);
+        return;
+    }
+
+    long long t0 = NowNs();
+    for (int step = 0; step < TICK_STEPS; step++) {
+        RunTickStep(step, cmds);
+        long long t1 = NowNs();
+        spent[step] += t1 - t0;
+        t0 = t1;
+    }
+}
+
+
+// ------------------------------
+// Un tick completo de simulación (cmds: un comando por jugador)
+// ------------------------------
+void GameTick(const InputCmd *cmds) {
+    if (!ProcessTickCommands(cmds)) return;
+    RunTickSteps(cmds, NULL);
+}
+
+
+// ------------------------------
+// Liberar la memoria del nivel
+// ------------------------------
+void UnloadLevel() {
+    if (gridsReady) {
+        FreeSpatialHash(&platformGrid);
+        FreeSpatialHash(&enemyGrid);
+        FreeSpatialHash(&collectibleGrid);
+        gridsReady = false;
+    }
+
+    FreePlatforms(&platforms);
+    UnmapLevel(&level);
+    FreeEnemies(&enemies);
+    FreeCollectibles(&collectibles);
+    FreeShoots(&shoot);
+
+    // Estado de carga, tramos, casillas y almacenes: todo en la arena
+    FreeArena(&levelArena);
+    stream = (LevelStream){ 0, -1 };
+    enemySpans = NULL;
+    tileMap = (TileMap){ 0 };
+
+    for (int j = 0; j < ENEMY_JOBS; j++) {
+        free(enemyEvents[j].events);
+        enemyEvents[j] = (EnemyEventBuffer){ 0 };
+    }
+    ShutdownJobPool();
+}
@@ -0,0 +1,303 @@
+// headless.c
+// Simulación sin ventana, audio ni texturas (benchmark y pruebas en CI)
+// -----------------------------------
+// Ejecuta la lógica de gameplay.c tan rápido como da la CPU con una entrada
+// guionizada (o una repetición grabada) y mide el tiempo de cada subsistema.
+//
+// Uso: headless [ticks] [--record archivo] [--replay archivo] [--snapshot]
+//                [--players 2] [--hash-out traza] [--hash-check traza]
+//                [--level archivo.lvl]
+//        headless [ticks] --net jugador puertoLocal puertoRemoto
+//                [--net-delay ms] [--net-jitter ms] [--net-loss pct]
+//   ticks      ticks a simular con la entrada guionizada (por defecto 200000)
+//   --record   guarda los comandos simulados como repetición (jugador 1)
+//   --replay   simula los comandos de una repetición en lugar del guion
+//   --snapshot en cada tick guarda el estado, simula el tick, lo restaura y
+//              lo vuelve a simular (como un rollback): el estado final debe
+//              ser el mismo que sin la opción
+//   --players  cooperativo local; el segundo jugador sigue el guion desfasado
+//   --level    nivel a simular en lugar del de por defecto
+//   --hash-out   escribe la huella del estado de cada tick ("tick huella")
+//   --hash-check compara cada tick con una traza de --hash-out y dice el
+//                primer tick distinto (código de salida 2)
+// Con --replay se comprueban además las huellas guardadas en la repetición.
+//   --net      cooperativo por red con rollback (netplay.c): se lanzan dos
+//              procesos, uno con jugador 0 y otro con jugador 1 y los puertos
+//              cruzados. Los dos deben acabar en el mismo estado final, y
+//              en el mismo que "--players 2" con los mismos ticks (misma
+//              huella final). Cada tick se compara la huella con la del
+//              otro: si alguna difiere, código de salida 2
+
+#define GAME_HEADLESS
+#include "gameplay.c"
+#include "statehash.c"          // Huella del estado por tick
+#include "replay.c"
+#include "snapshot.c"
+#include "netplay.c"
+#include "scripted.c"           // Entrada guionizada
+
+#define DEFAULT_TICKS 200000
+#define NET_TIMEOUT_NS 10000000000LL    // Sin progreso durante 10 s: el otro no está
+#define NET_LINGER_NS  1000000000LL     // Al acabar, tiempo para que el otro reciba lo último
+
+// Tiempo acumulado por subsistema: los pasos del tick (TICK_*, gameplay.c)
+// y después lo que añade el runner
+enum { T_HASH = TICK_STEPS, T_SAVE, T_RESTORE, T_COUNT };
+static const char *TimerName(int t) {
+    static const char *extra[T_COUNT - TICK_STEPS] = { "HashGameState", "SaveSnapshot", "RestoreSnapshot" };
+    return (t < TICK_STEPS) ? tickStepNames[t] : extra[t - TICK_STEPS];
+}
+
+static void PrintFinalState(void) {
+    for (int p = 0; p < playerCount; p++)
+        printf("estado final%s: x=%.9g y=%.9g vidas=%d puntaje=%d\n", (p == 0) ? "" : " j2",
+               players[p].pos.x, players[p].pos.y, players[p].lives, players[p].score);
+}
+
+// ------------------------------
+// Cooperativo por red: simula totalTicks con rollback y espera a tener
+// confirmadas todas las entradas del otro
+// ------------------------------
+static int RunNetSession(long long totalTicks, int index, int localPort, int remotePort,
+                         int delayMs, int jitterMs, int lossPercent) {
+
+    SetPlayerCount(2);
+    localPlayer = index;
+    ResetLevel();
+
+    NetSession net;
+    if (!StartNetSession(&net, index, localPort, remotePort)) {
+        fprintf(stderr, "headless: no se pudo abrir la sesión de red\n");
+        return 1;
+    }
+    SetNetShim(&net, delayMs, jitterMs, lossPercent);
+
+    long long start = NowNs(), lastProgress = start;
+    int lastTick = 0, lastConfirmed = 0;
+
+    while (net.tick < totalTicks || net.remoteConfirmed < totalTicks) {
+
+        if (net.tick < totalTicks) {
+            if (!NetTick(&net, ScriptedInputPlayer(index, net.tick))) NetIdle();
+        }
+        else {
+            UpdateNetSession(&net);
+            NetIdle();
+        }
+
+        long long now = NowNs();
+        if (net.tick != lastTick || net.remoteConfirmed != lastConfirmed) {
+            lastTick = net.tick;
+            lastConfirmed = net.remoteConfirmed;
+            lastProgress = now;
+        }
+        else if (now - lastProgress > NET_TIMEOUT_NS) {
+            fprintf(stderr, "headless: el otro jugador no responde (tick %d, confirmados %d)\n",
+                    net.tick, net.remoteConfirmed);
+            CloseNetSession(&net);
+            return 1;
+        }
+    }
+
+    double seconds = (NowNs() - start) / 1e9;
+
+    // El otro puede necesitar aún nuestras últimas entradas (si ya salió,
+    // su confirmación no llega y se espera solo NET_LINGER_NS)
+    long long linger = NowNs();
+    while (net.remoteAck < totalTicks && NowNs() - linger < NET_LINGER_NS) {
+        UpdateNetSession(&net);
+        NetIdle();
+    }
+    const NetStats *st = &net.stats;
+
+    printf("headless: red, jugador %d, %lld ticks en %.3f s\n", index, totalTicks, seconds);
+    printf("  rollbacks %lld, ticks resimulados %lld, esperas %lld\n", st->rollbacks, st->resimulated, st->stalls);
+    printf("  rollback más largo %d ticks, más lento %.3f ms\n", st->maxRollback, st->maxRollbackNs / 1e6);
+    printf("  paquetes enviados %lld (perdidos %lld), recibidos %lld\n",
+           st->packetsSent, st->packetsLost, st->packetsReceived);
+    PrintFinalState();
+    printf("huella final: %08x (%s)\n", (unsigned int)net.chain, STATE_HASH_NAME);
+
+    int status = 0;
+    if (st->desyncs > 0) {
+        printf("red: el estado del otro jugador se desvió entre los ticks %d y %d\n",
+               st->agreedTicks, st->desyncTick);
+        status = 2;
+    }
+
+    CloseNetSession(&net);
+    UnloadLevel();
+    return status;
+}
+
+int main(int argc, char **argv) {
+
+    long long totalTicks = DEFAULT_TICKS;
+    const char *recordPath = NULL;
+    const char *replayPath = NULL;
+    bool snapshotTest = false;
+    const char *hashOutPath = NULL;
+    const char *hashRefPath = NULL;
+    const char *levelArg = NULL;
+    int netIndex = -1, localPort = 0, remotePort = 0;
+    int netDelay = 0, netJitter = 0, netLoss = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) recordPath = argv[++i];
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) replayPath = argv[++i];
+        else if (strcmp(argv[i], "--snapshot") == 0) snapshotTest = true;
+        else if (strcmp(argv[i], "--hash-out") == 0 && i + 1 < argc) hashOutPath = argv[++i];
+        else if (strcmp(argv[i], "--hash-check") == 0 && i + 1 < argc) hashRefPath = argv[++i];
+        else if (strcmp(argv[i], "--players") == 0 && i + 1 < argc) SetPlayerCount(atoi(argv[++i]));
+        else if (strcmp(argv[i], "--level") == 0 && i + 1 < argc) levelArg = argv[++i];
+        else if (strcmp(argv[i], "--net") == 0 && i + 3 < argc) {
+            netIndex = (atoi(argv[++i]) != 0);
+            localPort = atoi(argv[++i]);
+            remotePort = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--net-delay") == 0 && i + 1 < argc) netDelay = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--net-jitter") == 0 && i + 1 < argc) netJitter = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--net-loss") == 0 && i + 1 < argc) netLoss = atoi(argv[++i]);
+        else if (atoll(argv[i]) > 0) totalTicks = atoll(argv[i]);
+    }
+
+    Replay replay = { 0 };
+    if (replayPath != NULL) {
+        if (!LoadReplay(&replay, replayPath)) {
+            fprintf(stderr, "headless: no se pudo cargar la repetición %s\n", replayPath);
+            return 1;
+        }
+        totalTicks = replay.count;
+    }
+
+    FILE *hashOut = NULL, *hashRef = NULL;
+    if (hashOutPath != NULL && (hashOut = fopen(hashOutPath, "w")) == NULL) {
+        fprintf(stderr, "headless: no se pudo crear la traza %s\n", hashOutPath);
+        return 1;
+    }
+    if (hashRefPath != NULL && (hashRef = fopen(hashRefPath, "r")) == NULL) {
+        fprintf(stderr, "headless: no se pudo abrir la traza %s\n", hashRefPath);
+        return 1;
+    }
+
+    InitPlayerAnimations();
+    InitEnemyAnimations();
+
+    if (levelArg != NULL && !LoadLevel(levelArg)) {
+        fprintf(stderr, "headless: no se pudo cargar el nivel %s\n", levelArg);
+        return 1;
+    }
+
+    if (netIndex >= 0)
+        return RunNetSession(totalTicks, netIndex, localPort, remotePort, netDelay, netJitter, netLoss);
+
+    ResetLevel();
+
+    GameSnapshot snapshot = { 0 };
+    InitSnapshot(&snapshot);
+
+    long long spent[T_COUNT] = { 0 };
+
+    // Huellas: encadenada de toda la ejecución y primer tick desviado de la
+    // repetición o de la traza de referencia (-1 = ninguno)
+    uint32_t chain = 0;
+    long long desyncTick = -1, traceTick = -1;
+
+    int runs = 1, wins = 0, losses = 0;
+
+    long long start = NowNs();
+
+    for (long long tick = 0; tick < totalTicks; tick++) {
+
+        InputCmd cmds[MAX_PLAYERS];
+        for (int p = 0; p < playerCount; p++) cmds[p] = ScriptedInputPlayer(p, tick);
+        if (replayPath != NULL) NextReplayCmd(&replay, &cmds[0]);
+        if (recordPath != NULL) AppendReplay(&replay, cmds[0]);
+
+        bool reset = false;
+        for (int p = 0; p < playerCount; p++) reset |= (cmds[p].buttons & INPUT_RESET) != 0;
+        if (reset) {
+            if (victory) wins++; else if (gameOver) losses++;
+            runs++;
+        }
+
+        long long t0, t1;
+
+        // Rollback de prueba: el tick se simula, se deshace y se repite
+        if (snapshotTest) {
+            t0 = NowNs();
+            SaveSnapshot(&snapshot);
+            t1 = NowNs(); spent[T_SAVE] += t1 - t0;
+
+            GameTick(cmds);
+
+            t0 = NowNs();
+            if (!RestoreSnapshot(&snapshot)) {
+                fprintf(stderr, "headless: no se pudo restaurar la instantánea en el tick %lld\n", tick);
+                return 1;
+            }
+            t1 = NowNs(); spent[T_RESTORE] += t1 - t0;
+        }
+
+        // Mismo orden que GameTick, midiendo cada paso
+        if (ProcessTickCommands(cmds)) RunTickSteps(cmds, spent);
+
+        // Huella del estado tras el tick
+        t0 = NowNs();
+        uint32_t tickHash = HashGameState();
+        spent[T_HASH] += NowNs() - t0;
+        chain = ChainStateHash(chain, tickHash);
+
+        if (replayPath != NULL) {
+            if (!CheckReplayHash(&replay, tickHash) && desyncTick < 0) desyncTick = tick;
+        }
+        else if (recordPath != NULL) RecordReplayHash(&replay, tickHash);
+
+        if (hashOut != NULL) fprintf(hashOut, "%lld %08x\n", tick, (unsigned int)tickHash);
+        if (hashRef != NULL && traceTick < 0) {
+            long long refTick;
+            unsigned int refHash;
+            if (fscanf(hashRef, "%lld %x", &refTick, &refHash) != 2 || refTick != tick || refHash != tickHash)
+                traceTick = tick;
+        }
+    }
+
+    long long elapsed = NowNs() - start;
+    double seconds = elapsed / 1e9;
+
+    printf("headless: %lld ticks en %.3f s (%.0f ticks/s, SIM_HZ=%d)\n",
+           totalTicks, seconds, totalTicks / (seconds > 0 ? seconds : 1e-9), SIM_HZ);
+    printf("partidas: %d (victorias %d, derrotas %d)\n", runs, wins, losses);
+
+    for (int i = 0; i < T_COUNT; i++) {
+        if ((i == T_SAVE || i == T_RESTORE) && !snapshotTest) continue;
+        if (i == T_HASH && STATE_HASH_ALGO == 0) continue;
+        printf("  %-20s %10.1f ns/tick\n", TimerName(i), (double)spent[i] / totalTicks);
+    }
+
+    printf("  %-20s %10.1f ns/tick\n", "total", (double)elapsed / totalTicks);
+    if (snapshotTest) printf("  instantánea: %zu bytes (reservados %zu)\n", snapshot.size, snapshot.capacity);
+    PrintFinalState();
+    printf("huella final: %08x (%s)\n", (unsigned int)chain, STATE_HASH_NAME);
+
+    int status = 0;
+    if (desyncTick >= 0) {
+        long long first = desyncTick - desyncTick % REPLAY_HASH_INTERVAL;
+        printf("repetición: la simulación se desvió entre los ticks %lld y %lld\n", first, desyncTick);
+        status = 2;
+    }
+    if (traceTick >= 0) {
+        printf("traza: la huella cambia en el tick %lld\n", traceTick);
+        status = 2;
+    }
+    if (hashOut != NULL) fclose(hashOut);
+    if (hashRef != NULL) fclose(hashRef);
+
+    if (recordPath != NULL && !SaveReplay(&replay, recordPath))
+        fprintf(stderr, "headless: no se pudo guardar la repetición %s\n", recordPath);
+
+    FreeReplay(&replay);
+    FreeSnapshot(&snapshot);
+    UnloadLevel();
+    return status;
+}
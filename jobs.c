@@ -0,0 +1,171 @@
+// jobs.c
+// Grupo de hilos de trabajo para repartir bucles de la simulación
+// -----------------------------------
+// RunJobs(fn, ctx, n) ejecuta fn(0..n-1) repartido entre los hilos del
+// grupo y el hilo que llama, y vuelve cuando han terminado todos. Cada
+// trabajo debe escribir solo en sus propios datos: el orden en que se
+// ejecutan no está definido, así que quien llama combina los resultados
+// en el orden de los índices para que sean deterministas.
+//
+// Si no se pueden crear hilos (p. ej. web sin soporte de hilos) o se
+// compila con GAME_NO_THREADS, los trabajos se ejecutan en el hilo actual.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#if !defined(GAME_NO_THREADS)
+    #include <pthread.h>
+    #if !defined(_WIN32)
+        #include <unistd.h>
+    #endif
+#endif
+
+#define MAX_JOB_THREADS 16
+
+typedef void (*JobFunc)(int job, void *ctx);
+
+#if !defined(GAME_NO_THREADS)
+
+typedef struct JobPool {
+    pthread_t threads[MAX_JOB_THREADS];
+    int threadCount;                // Hilos de trabajo (sin contar el que llama)
+    pthread_mutex_t lock;
+    pthread_cond_t wake;            // Hay una tanda nueva o hay que salir
+    pthread_cond_t done;            // La tanda terminó
+    unsigned int generation;        // Tanda actual
+    JobFunc fn;
+    void *ctx;
+    int jobCount;
+    int nextJob;                    // Siguiente trabajo por repartir
+    int pending;                    // Trabajos aún sin terminar
+    bool quit;
+} JobPool;
+
+static JobPool jobPool = { 0 };
+static bool jobPoolReady = false;
+
+// Toma trabajos de la tanda actual hasta que no quede ninguno
+static void DrainJobs(JobPool *p) {
+    for (;;) {
+        int job = p->nextJob;
+        if (job >= p->jobCount) return;
+        p->nextJob++;
+
+        pthread_mutex_unlock(&p->lock);
+        p->fn(job, p->ctx);
+        pthread_mutex_lock(&p->lock);
+
+        if (--p->pending == 0) pthread_cond_signal(&p->done);
+    }
+}
+
+static void *JobWorker(void *arg) {
+    JobPool *p = arg;
+    unsigned int seen = 0;
+
+    pthread_mutex_lock(&p->lock);
+    for (;;) {
+        while (!p->quit && p->generation == seen) pthread_cond_wait(&p->wake, &p->lock);
+        if (p->quit) break;
+
+        seen = p->generation;
+        DrainJobs(p);
+    }
+    pthread_mutex_unlock(&p->lock);
+    return NULL;
+}
+
+// Núcleos disponibles (1 si no se sabe)
+static int CountCores(void) {
+#if defined(_WIN32)
+    const char *n = getenv("NUMBER_OF_PROCESSORS");
+    int cores = (n != NULL) ? atoi(n) : 1;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    int cores = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#else
+    int cores = 1;
+#endif
+    return (cores > 0) ? cores : 1;
+}
+
+// Crea hasta maxThreads hilos de trabajo, sin pasar de un hilo por núcleo
+// libre (el hilo que llama a RunJobs también trabaja)
+void InitJobPool(int maxThreads) {
+    if (jobPoolReady) return;
+
+    int threadCount = CountCores() - 1;
+    if (threadCount > maxThreads) threadCount = maxThreads;
+    if (threadCount > MAX_JOB_THREADS) threadCount = MAX_JOB_THREADS;
+
+    JobPool *p = &jobPool;
+    *p = (JobPool){ 0 };
+    pthread_mutex_init(&p->lock, NULL);
+    pthread_cond_init(&p->wake, NULL);
+    pthread_cond_init(&p->done, NULL);
+
+    for (int i = 0; i < threadCount; i++) {
+        if (pthread_create(&p->threads[p->threadCount], NULL, JobWorker, p) != 0) {
+            fprintf(stderr, "jobs: no se pudo crear el hilo %d, se usan %d\n", i, p->threadCount);
+            break;
+        }
+        p->threadCount++;
+    }
+    jobPoolReady = true;
+}
+
+// Hilos de trabajo en marcha (0 si el grupo no existe)
+int JobPoolWorkers(void) {
+    return jobPoolReady ? jobPool.threadCount : 0;
+}
+
+void ShutdownJobPool(void) {
+    if (!jobPoolReady) return;
+    JobPool *p = &jobPool;
+
+    pthread_mutex_lock(&p->lock);
+    p->quit = true;
+    pthread_cond_broadcast(&p->wake);
+    pthread_mutex_unlock(&p->lock);
+
+    for (int i = 0; i < p->threadCount; i++) pthread_join(p->threads[i], NULL);
+
+    pthread_mutex_destroy(&p->lock);
+    pthread_cond_destroy(&p->wake);
+    pthread_cond_destroy(&p->done);
+    jobPoolReady = false;
+}
+
+void RunJobs(JobFunc fn, void *ctx, int jobCount) {
+    JobPool *p = &jobPool;
+
+    if (!jobPoolReady || p->threadCount == 0 || jobCount <= 1) {
+        for (int j = 0; j < jobCount; j++) fn(j, ctx);
+        return;
+    }
+
+    pthread_mutex_lock(&p->lock);
+    p->fn = fn;
+    p->ctx = ctx;
+    p->jobCount = jobCount;
+    p->nextJob = 0;
+    p->pending = jobCount;
+    p->generation++;
+    pthread_cond_broadcast(&p->wake);
+
+    DrainJobs(p);
+    while (p->pending > 0) pthread_cond_wait(&p->done, &p->lock);
+    pthread_mutex_unlock(&p->lock);
+}
+
+#else
+
+void InitJobPool(int maxThreads) { (void)maxThreads; }
+int JobPoolWorkers(void) { return 0; }
+void ShutdownJobPool(void) { }
+
+void RunJobs(JobFunc fn, void *ctx, int jobCount) {
+    for (int j = 0; j < jobCount; j++) fn(j, ctx);
+}
+
+#endif
@@ -0,0 +1,429 @@
+// level.c
+// Niveles en formato binario (.lvl) mapeados en memoria
+// -----------------------------------
+// El archivo se mapea tal cual (mmap) y sus arrays se usan en el sitio:
+// no hay parseo ni una reserva por entidad. Las plataformas se leen
+// directamente del mapeo; enemigos y objetos copian sus posiciones
+// iniciales al cargarse el trozo (chunk) del nivel que les toca.
+//
+// Formato (little endian, todo alineado a 4 bytes):
+//   LevelHeader
+//   Rectangle  platformBox[platformCount]      ordenadas por X
+//   int32      platformType[platformCount]
+//   Vector2    enemySpawn[enemyCount]          ordenados por X
+//   uint8      enemyType[enemyCount]           arquetipo de cada uno (enemy_types.c)
+//   Vector2    collectibleSpawn[collectibleCount]
+//   LevelChunk chunks[chunkCount]              trozos de chunkWidth en X
+//   int32      chunkPlatforms[chunkPlatformCount]
+//   uint8      tiles[tileCols*tileRows]        capa de casillas opcional
+// Cada sección se localiza por su offset en la cabecera. Una plataforma
+// aparece en la lista de cada trozo que toca; enemigos y objetos
+// pertenecen al trozo de su X inicial (rangos contiguos). La capa de
+// casillas (ver tilemap.c) es un byte por casilla, por filas, y no se
+// reparte por trozos: cuesta un bit de solidez por casilla tenerla entera.
+//
+// Los .lvl se generan desde texto con levelconv (ver levelconv.c).
+
+#include "raylib.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <sys/stat.h>
+
+#if !defined(_WIN32)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+#endif
+
+#define LEVEL_VERSION 4
+#define LEVEL_CHUNK_WIDTH 512.0f    // Ancho de trozo por defecto (unidades de mundo)
+
+typedef struct LevelHeader {
+    char magic[4];              // "PLVL"
+    uint32_t version;
+    uint32_t fileSize;
+    float spawnX, spawnY;       // Inicio del jugador
+    float goalX;                // Meta
+    uint32_t platformCount;
+    uint32_t enemyCount;
+    uint32_t collectibleCount;
+    uint32_t platformBoxOffset;
+    uint32_t platformTypeOffset;
+    uint32_t enemyOffset;
+    uint32_t enemyTypeOffset;
+    uint32_t collectibleOffset;
+    float chunkWidth;
+    uint32_t chunkCount;
+    uint32_t chunkOffset;
+    uint32_t chunkPlatformCount;
+    uint32_t chunkPlatformOffset;
+    uint32_t tileCols, tileRows;    // 0 = sin casillas
+    float tileSize;
+    float tileOriginX, tileOriginY; // Esquina de la casilla (0, 0)
+    uint32_t tileOffset;
+} LevelHeader;
+
+// Capa de casillas al construir un nivel: tipo por casilla, 0 = vacía
+typedef struct LevelTiles {
+    int cols, rows;
+    float size;
+    Vector2 origin;
+    const unsigned char *type;
+} LevelTiles;
+
+// Trozo del nivel: rangos dentro de cada sección
+typedef struct LevelChunk {
+    uint32_t platformFirst, platformCount;          // en chunkPlatforms
+    uint32_t enemyFirst, enemyCount;                // en enemySpawn
+    uint32_t collectibleFirst, collectibleCount;    // en collectibleSpawn
+} LevelChunk;
+
+// Nivel cargado: punteros dentro del mapeo
+typedef struct LevelData {
+    void *mapping;              // Memoria del archivo (mmap o bloque leído)
+    size_t size;
+    bool heap;                  // mapping se liberó con malloc (no mmap)
+    long long stamp;            // Huella del archivo (recargar si cambia)
+    const LevelHeader *header;
+    Rectangle *platformBox;
+    int32_t *platformType;
+    const Vector2 *enemySpawn;
+    const unsigned char *enemyType;
+    const Vector2 *collectibleSpawn;
+    const LevelChunk *chunks;
+    const int32_t *chunkPlatforms;
+    const unsigned char *tiles;     // NULL si el nivel no tiene casillas
+} LevelData;
+
+// ----------------------------------------------------------------------
+// Utilidades
+// ----------------------------------------------------------------------
+// Huella del archivo (fecha, tamaño e inodo); -1 si no existe
+static long long FileStamp(const char *path) {
+    struct stat st;
+    if (stat(path, &st) != 0) return -1;
+    return (long long)st.st_mtime ^ ((long long)st.st_size << 32) ^ ((long long)st.st_ino << 16);
+}
+
+static bool SectionFits(size_t size, uint32_t offset, uint32_t count, size_t elem) {
+    return (offset % 4 == 0) && offset >= sizeof(LevelHeader) &&
+           (uint64_t)offset + (uint64_t)count*elem <= size;
+}
+
+// Trozo que contiene la coordenada X (los extremos se recortan)
+static int ChunkIndex(float x, float width, int chunkCount) {
+    float c = floorf(x / width);
+    if (c < 0) return 0;
+    if (c > (float)(chunkCount - 1)) return chunkCount - 1;
+    return (int)c;
+}
+
+int LevelChunkOf(const LevelHeader *h, float x) {
+    return ChunkIndex(x, h->chunkWidth, (int)h->chunkCount);
+}
+
+// ----------------------------------------------------------------------
+// Mapear / liberar
+// ----------------------------------------------------------------------
+void UnmapLevel(LevelData *lvl) {
+    if (lvl->mapping != NULL && lvl->heap) free(lvl->mapping);
+#if !defined(_WIN32)
+    else if (lvl->mapping != NULL) munmap(lvl->mapping, lvl->size);
+#endif
+    *lvl = (LevelData){ 0 };
+    lvl->stamp = -1;
+}
+
+// Valida una imagen de nivel completa y apunta los arrays dentro de ella.
+// Si falla, la memoria se libera.
+static bool AttachLevel(LevelData *lvl, void *mem, size_t size, bool heap) {
+    const LevelHeader *h = mem;
+    bool valid = size >= sizeof(LevelHeader) &&
+        memcmp(h->magic, "PLVL", 4) == 0 &&
+        h->version == LEVEL_VERSION &&
+        h->fileSize == size &&
+        h->chunkWidth > 0 && h->chunkCount > 0 &&
+        SectionFits(size, h->platformBoxOffset, h->platformCount, sizeof(Rectangle)) &&
+        SectionFits(size, h->platformTypeOffset, h->platformCount, sizeof(int32_t)) &&
+        SectionFits(size, h->enemyOffset, h->enemyCount, sizeof(Vector2)) &&
+        SectionFits(size, h->enemyTypeOffset, h->enemyCount, 1) &&
+        SectionFits(size, h->collectibleOffset, h->collectibleCount, sizeof(Vector2)) &&
+        SectionFits(size, h->chunkOffset, h->chunkCount, sizeof(LevelChunk)) &&
+        SectionFits(size, h->chunkPlatformOffset, h->chunkPlatformCount, sizeof(int32_t)) &&
+        (h->tileCols == 0 || h->tileRows == 0 ||
+         (h->tileSize > 0 && SectionFits(size, h->tileOffset, h->tileRows, h->tileCols)));
+
+    unsigned char *base = mem;
+
+    // Los rangos de cada trozo deben caer dentro de sus secciones
+    const LevelChunk *chunks = (const LevelChunk *)(base + h->chunkOffset);
+    for (uint32_t c = 0; valid && c < h->chunkCount; c++) {
+        const LevelChunk *k = &chunks[c];
+        valid = (uint64_t)k->platformFirst + k->platformCount <= h->chunkPlatformCount &&
+                (uint64_t)k->enemyFirst + k->enemyCount <= h->enemyCount &&
+                (uint64_t)k->collectibleFirst + k->collectibleCount <= h->collectibleCount;
+    }
+
+    const int32_t *chunkPlatforms = (const int32_t *)(base + h->chunkPlatformOffset);
+    for (uint32_t i = 0; valid && i < h->chunkPlatformCount; i++)
+        valid = chunkPlatforms[i] >= 0 && (uint32_t)chunkPlatforms[i] < h->platformCount;
+
+    if (!valid) {
+        LevelData tmp = { mem, size, heap };
+        UnmapLevel(&tmp);
+        return false;
+    }
+
+    UnmapLevel(lvl);
+
+    lvl->mapping = mem;
+    lvl->size = size;
+    lvl->heap = heap;
+    lvl->header = h;
+    lvl->platformBox = (Rectangle *)(base + h->platformBoxOffset);
+    lvl->platformType = (int32_t *)(base + h->platformTypeOffset);
+    lvl->enemySpawn = (const Vector2 *)(base + h->enemyOffset);
+    lvl->enemyType = base + h->enemyTypeOffset;
+    lvl->collectibleSpawn = (const Vector2 *)(base + h->collectibleOffset);
+    lvl->chunks = chunks;
+    lvl->chunkPlatforms = chunkPlatforms;
+    lvl->tiles = (h->tileCols > 0 && h->tileRows > 0) ? base + h->tileOffset : NULL;
+    return true;
+}
+
+bool MapLevel(LevelData *lvl, const char *path) {
+    void *mem = NULL;
+    size_t size = 0;
+    bool heap;
+
+#if defined(_WIN32)
+    // Sin mmap: una sola lectura del archivo completo
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) return false;
+    fseek(f, 0, SEEK_END);
+    size = (size_t)ftell(f);
+    fseek(f, 0, SEEK_SET);
+    mem = malloc(size > 0 ? size : 1);
+    if (fread(mem, 1, size, f) != size) { free(mem); fclose(f); return false; }
+    fclose(f);
+    heap = true;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(LevelHeader)) { close(fd); return false; }
+    size = (size_t)st.st_size;
+
+    // Privado: si algo escribiera en el mapeo, el archivo no cambia
+    mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) return false;
+    heap = false;
+#endif
+
+    if (!AttachLevel(lvl, mem, size, heap)) return false;
+    lvl->stamp = FileStamp(path);
+    return true;
+}
+
+// true si el archivo en disco no es el que está mapeado (nuevo, cambiado o creado)
+bool LevelFileChanged(const LevelData *lvl, const char *path) {
+    return FileStamp(path) != lvl->stamp;
+}
+
+// ----------------------------------------------------------------------
+// Construir una imagen de nivel en memoria (mismo contenido que el .lvl).
+// Ordena por X y genera la tabla de trozos. enemyType (todos 0) y tiles
+// pueden ser NULL.
+// Devuelve un bloque de malloc.
+// ----------------------------------------------------------------------
+typedef struct SortKey { float x; int index; } SortKey;
+
+static int CompareSortKey(const void *a, const void *b) {
+    const SortKey *ka = a, *kb = b;
+    if (ka->x != kb->x) return (ka->x < kb->x) ? -1 : 1;
+    return ka->index - kb->index;       // estable
+}
+
+// x apunta al campo x del primer elemento; stride es el tamaño del elemento
+static SortKey *SortByX(const void *x, size_t stride, int count) {
+    SortKey *keys = malloc((count > 0 ? count : 1)*sizeof(SortKey));
+    for (int i = 0; i < count; i++)
+        keys[i] = (SortKey){ *(const float *)((const char *)x + i*stride), i };
+    qsort(keys, count, sizeof(SortKey), CompareSortKey);
+    return keys;
+}
+
+void *BuildLevelImage(Vector2 spawn, float goalX, float chunkWidth,
+                      const Rectangle *platformBox, const int32_t *platformType, int platformCount,
+                      const Vector2 *enemySpawn, const unsigned char *enemyType, int enemyCount,
+                      const Vector2 *collectibleSpawn, int collectibleCount,
+                      const LevelTiles *tiles, size_t *outSize) {
+
+    if (chunkWidth <= 0) chunkWidth = LEVEL_CHUNK_WIDTH;
+
+    // Extensión del nivel en X: cubre todas las entidades y la meta
+    float maxX = fmaxf(goalX, spawn.x);
+    for (int i = 0; i < platformCount; i++) maxX = fmaxf(maxX, platformBox[i].x + platformBox[i].width);
+    for (int i = 0; i < enemyCount; i++) maxX = fmaxf(maxX, enemySpawn[i].x);
+    for (int i = 0; i < collectibleCount; i++) maxX = fmaxf(maxX, collectibleSpawn[i].x);
+    if (tiles != NULL && tiles->cols > 0) maxX = fmaxf(maxX, tiles->origin.x + tiles->cols*tiles->size);
+    int chunkCount = ChunkIndex(maxX, chunkWidth, 1 << 24) + 1;
+
+    SortKey *pk = SortByX(platformBox, sizeof(Rectangle), platformCount);
+    SortKey *ek = SortByX(enemySpawn, sizeof(Vector2), enemyCount);
+    SortKey *ck = SortByX(collectibleSpawn, sizeof(Vector2), collectibleCount);
+
+    // Entradas de plataformas por trozo (una por cada trozo que toca)
+    int chunkPlatformCount = 0;
+    for (int i = 0; i < platformCount; i++) {
+        Rectangle b = platformBox[i];
+        chunkPlatformCount += ChunkIndex(b.x + b.width, chunkWidth, chunkCount) - ChunkIndex(b.x, chunkWidth, chunkCount) + 1;
+    }
+
+    LevelHeader h = { { 'P', 'L', 'V', 'L' }, LEVEL_VERSION };
+    h.spawnX = spawn.x;
+    h.spawnY = spawn.y;
+    h.goalX = goalX;
+    h.platformCount = (uint32_t)platformCount;
+    h.enemyCount = (uint32_t)enemyCount;
+    h.collectibleCount = (uint32_t)collectibleCount;
+    h.chunkWidth = chunkWidth;
+    h.chunkCount = (uint32_t)chunkCount;
+    h.chunkPlatformCount = (uint32_t)chunkPlatformCount;
+    int tileCount = 0;
+    if (tiles != NULL && tiles->cols > 0 && tiles->rows > 0 && tiles->size > 0) {
+        h.tileCols = (uint32_t)tiles->cols;
+        h.tileRows = (uint32_t)tiles->rows;
+        h.tileSize = tiles->size;
+        h.tileOriginX = tiles->origin.x;
+        h.tileOriginY = tiles->origin.y;
+        tileCount = tiles->cols*tiles->rows;
+    }
+
+    uint32_t offset = sizeof(LevelHeader);
+    h.platformBoxOffset = offset;   offset += platformCount*sizeof(Rectangle);
+    h.platformTypeOffset = offset;  offset += platformCount*sizeof(int32_t);
+    h.enemyOffset = offset;         offset += enemyCount*sizeof(Vector2);
+    h.enemyTypeOffset = offset;     offset += (enemyCount + 3) & ~3;
+    h.collectibleOffset = offset;   offset += collectibleCount*sizeof(Vector2);
+    h.chunkOffset = offset;         offset += chunkCount*sizeof(LevelChunk);
+    h.chunkPlatformOffset = offset; offset += chunkPlatformCount*sizeof(int32_t);
+    h.tileOffset = offset;          offset += (tileCount + 3) & ~3;
+    h.fileSize = offset;
+
+    unsigned char *image = calloc(1, offset);
+    if (image == NULL) { free(pk); free(ek); free(ck); return NULL; }
+    memcpy(image, &h, sizeof(h));
+
+    Rectangle *box = (Rectangle *)(image + h.platformBoxOffset);
+    int32_t *type = (int32_t *)(image + h.platformTypeOffset);
+    Vector2 *enemy = (Vector2 *)(image + h.enemyOffset);
+    unsigned char *enemyArchetype = image + h.enemyTypeOffset;
+    Vector2 *item = (Vector2 *)(image + h.collectibleOffset);
+    LevelChunk *chunks = (LevelChunk *)(image + h.chunkOffset);
+    int32_t *chunkPlatforms = (int32_t *)(image + h.chunkPlatformOffset);
+
+    for (int i = 0; i < platformCount; i++) {
+        box[i] = platformBox[pk[i].index];
+        type[i] = platformType[pk[i].index];
+    }
+    for (int i = 0; i < enemyCount; i++) {
+        enemy[i] = enemySpawn[ek[i].index];
+        enemyArchetype[i] = (enemyType != NULL) ? enemyType[ek[i].index] : 0;
+    }
+    for (int i = 0; i < collectibleCount; i++) item[i] = collectibleSpawn[ck[i].index];
+    if (tileCount > 0) memcpy(image + h.tileOffset, tiles->type, tileCount);
+
+    // Plataformas por trozo: contar, sumar prefijos y repartir
+    // (dentro de cada trozo quedan en orden creciente de índice)
+    for (int i = 0; i < platformCount; i++) {
+        int c0 = ChunkIndex(box[i].x, chunkWidth, chunkCount);
+        int c1 = ChunkIndex(box[i].x + box[i].width, chunkWidth, chunkCount);
+        for (int c = c0; c <= c1; c++) chunks[c].platformCount++;
+    }
+    for (int c = 0, first = 0; c < chunkCount; c++) {
+        chunks[c].platformFirst = (uint32_t)first;
+        first += (int)chunks[c].platformCount;
+        chunks[c].platformCount = 0;
+    }
+    for (int i = 0; i < platformCount; i++) {
+        int c0 = ChunkIndex(box[i].x, chunkWidth, chunkCount);
+        int c1 = ChunkIndex(box[i].x + box[i].width, chunkWidth, chunkCount);
+        for (int c = c0; c <= c1; c++)
+            chunkPlatforms[chunks[c].platformFirst + chunks[c].platformCount++] = i;
+    }
+
+    // Enemigos y objetos: como están ordenados por X, cada rango es contiguo
+    int e = 0, o = 0;
+    for (int c = 0; c < chunkCount; c++) {
+        LevelChunk *k = &chunks[c];
+
+        k->enemyFirst = (uint32_t)e;
+        while (e < enemyCount && ChunkIndex(enemy[e].x, chunkWidth, chunkCount) == c) e++;
+        k->enemyCount = (uint32_t)e - k->enemyFirst;
+
+        k->collectibleFirst = (uint32_t)o;
+        while (o < collectibleCount && ChunkIndex(item[o].x, chunkWidth, chunkCount) == c) o++;
+        k->collectibleCount = (uint32_t)o - k->collectibleFirst;
+    }
+
+    free(pk);
+    free(ek);
+    free(ck);
+
+    *outSize = offset;
+    return image;
+}
+
+// Usa una imagen de BuildLevelImage como nivel actual (toma su memoria)
+bool UseLevelImage(LevelData *lvl, void *image, size_t size) {
+    if (image == NULL) return false;
+    return AttachLevel(lvl, image, size, true);
+}
+
+// ----------------------------------------------------------------------
+// Escribir un .lvl (lo usan las herramientas)
+// Se escribe en un temporal y se renombra: un juego que tenga mapeado
+// el archivo anterior sigue leyendo el suyo sin errores.
+// ----------------------------------------------------------------------
+bool SaveLevelImage(const char *path, const void *image, size_t size) {
+    char tmpPath[1024];
+    snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
+
+    FILE *f = fopen(tmpPath, "wb");
+    if (f == NULL) return false;
+
+    fwrite(image, 1, size, f);
+
+    bool ok = (ferror(f) == 0);
+    fclose(f);
+
+    if (ok) {
+#if defined(_WIN32)
+        remove(path);   // En Windows rename no sobrescribe
+#endif
+        ok = (rename(tmpPath, path) == 0);
+    }
+    return ok;
+}
+
+bool SaveLevelFile(const char *path, Vector2 spawn, float goalX, float chunkWidth,
+                   const Rectangle *platformBox, const int32_t *platformType, int platformCount,
+                   const Vector2 *enemySpawn, const unsigned char *enemyType, int enemyCount,
+                   const Vector2 *collectibleSpawn, int collectibleCount,
+                   const LevelTiles *tiles) {
+
+    size_t size = 0;
+    void *image = BuildLevelImage(spawn, goalX, chunkWidth, platformBox, platformType, platformCount,
+                                  enemySpawn, enemyType, enemyCount, collectibleSpawn, collectibleCount, tiles, &size);
+    if (image == NULL) return false;
+
+    bool ok = SaveLevelImage(path, image, size);
+    free(image);
+    return ok;
+}
@@ -0,0 +1,213 @@
+// levelconv.c
+// Conversor de niveles: texto (.txt) -> binario (.lvl)
+// -----------------------------------
+// Uso: levelconv entrada.txt salida.lvl
+//      levelconv --stress N semilla salida.lvl   nivel generado (ver stresslevel.c)
+//
+// Formato de texto, una entidad por línea ('#' inicia un comentario):
+//   inicio x y                      posición inicial del jugador
+//   meta x                          coordenada X de la meta
+//   trozo ancho                     ancho de los trozos de carga (opcional)
+//   plataforma x y ancho alto tipo  tipo 4 = suelo
+//   enemigo x y [tipo]              tipo de enemigo (enemy_types.c): 0 seta
+//                                   (por defecto), 1 rata, 2 rata 2, 3 pájaro
+//   objeto x y
+//   casillas tamaño x y             rejilla de casillas (opcional): tamaño de
+//                                   casilla y esquina de la primera
+//   fila ..==..33..                 una fila de casillas por línea, de arriba
+//                                   abajo: '.' vacía, '=' suelo (tipo 4),
+//                                   '0'..'9' y 'a' tipos 0..10
+
+#include "raylib.h"
+#include "level.c"
+#include "stresslevel.c"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Array que crece al añadir (solo para la herramienta)
+static void *Push(void *data, int *count, int *capacity, size_t elemSize) {
+    if (*count == *capacity) {
+        *capacity = (*capacity > 0) ? *capacity*2 : 64;
+        data = realloc(data, (size_t)*capacity*elemSize);
+        if (data == NULL) { fprintf(stderr, "levelconv: sin memoria\n"); exit(1); }
+    }
+    (*count)++;
+    return data;
+}
+
+// Nivel de prueba generado: N plataformas, enemigos y objetos
+static int WriteStressLevel(int count, uint32_t seed, const char *path) {
+    size_t size = 0;
+    void *image = GenerateStressLevel(seed, count, 0, &size);
+
+    bool ok = image != NULL && SaveLevelImage(path, image, size);
+    free(image);
+
+    if (!ok) {
+        fprintf(stderr, "levelconv: no se pudo escribir %s\n", path);
+        return 1;
+    }
+    printf("%s: %d plataformas, %d enemigos, %d objetos (semilla %u)\n", path, count, count, count, seed);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+
+    if (argc == 5 && strcmp(argv[1], "--stress") == 0 && atoi(argv[2]) > 0)
+        return WriteStressLevel(atoi(argv[2]), (uint32_t)strtoul(argv[3], NULL, 10), argv[4]);
+
+    if (argc != 3) {
+        fprintf(stderr, "uso: levelconv entrada.txt salida.lvl\n"
+                        "     levelconv --stress N semilla salida.lvl\n");
+        return 1;
+    }
+
+    FILE *f = fopen(argv[1], "r");
+    if (f == NULL) {
+        fprintf(stderr, "levelconv: no se pudo abrir %s\n", argv[1]);
+        return 1;
+    }
+
+    Vector2 spawn = { 120, 300 };
+    float goalX = 0;
+    float chunkWidth = LEVEL_CHUNK_WIDTH;
+    bool hasGoal = false;
+
+    Rectangle *box = NULL;   int32_t *type = NULL;
+    int platformCount = 0,   platformCap = 0, typeCount = 0, typeCap = 0;
+    Vector2 *enemy = NULL;   int enemyCount = 0, enemyCap = 0;
+    unsigned char *enemyType = NULL;        int enemyTypeCount = 0, enemyTypeCap = 0;
+    Vector2 *item = NULL;    int itemCount = 0, itemCap = 0;
+
+    LevelTiles tiles = { 0 };
+    bool hasTiles = false;
+    unsigned char *tileType = NULL;         // Filas de ancho tileCap (se ajusta al final)
+    int tileRows = 0, tileRowCap = 0, tileCols = 0, tileCap = 0;
+
+    char line[4096];
+    int lineNo = 0;
+    int errors = 0;
+
+    while (fgets(line, sizeof(line), f) != NULL) {
+        lineNo++;
+
+        char *hash = strchr(line, '#');
+        if (hash != NULL) *hash = '\0';
+
+        char word[32];
+        if (sscanf(line, "%31s", word) != 1) continue;     // línea vacía
+
+        float x, y, w, h;
+        int t;
+
+        if (strcmp(word, "inicio") == 0 && sscanf(line, "%*s %f %f", &x, &y) == 2) {
+            spawn = (Vector2){ x, y };
+        }
+        else if (strcmp(word, "meta") == 0 && sscanf(line, "%*s %f", &x) == 1) {
+            goalX = x;
+            hasGoal = true;
+        }
+        else if (strcmp(word, "trozo") == 0 && sscanf(line, "%*s %f", &x) == 1 && x > 0) {
+            chunkWidth = x;
+        }
+        else if (strcmp(word, "plataforma") == 0 && sscanf(line, "%*s %f %f %f %f %d", &x, &y, &w, &h, &t) == 5) {
+            box = Push(box, &platformCount, &platformCap, sizeof(Rectangle));
+            type = Push(type, &typeCount, &typeCap, sizeof(int32_t));
+            box[platformCount - 1] = (Rectangle){ x, y, w, h };
+            type[typeCount - 1] = t;
+        }
+        else if (strcmp(word, "enemigo") == 0 && sscanf(line, "%*s %f %f", &x, &y) == 2) {
+            t = 0;
+            if (sscanf(line, "%*s %*f %*f %d", &t) == 1 && (t < 0 || t > 255)) {
+                fprintf(stderr, "%s:%d: tipo de enemigo no válido: %d\n", argv[1], lineNo, t);
+                errors++;
+            }
+            enemy = Push(enemy, &enemyCount, &enemyCap, sizeof(Vector2));
+            enemyType = Push(enemyType, &enemyTypeCount, &enemyTypeCap, 1);
+            enemy[enemyCount - 1] = (Vector2){ x, y };
+            enemyType[enemyTypeCount - 1] = (unsigned char)t;
+        }
+        else if (strcmp(word, "casillas") == 0 && sscanf(line, "%*s %f %f %f", &w, &x, &y) == 3 && w > 0) {
+            tiles.size = w;
+            tiles.origin = (Vector2){ x, y };
+            hasTiles = true;
+        }
+        else if (strcmp(word, "fila") == 0 && hasTiles) {
+            char row[sizeof(line)] = "";
+            sscanf(line, "%*s %4095s", row);
+            int n = (int)strlen(row);
+
+            // Ancho nuevo: rehacer las filas anteriores con el ancho mayor
+            if (n > tileCap) {
+                int cap = (tileCap > 0) ? tileCap : 64;
+                while (cap < n) cap *= 2;
+                unsigned char *grown = calloc((size_t)cap*(tileRowCap > 0 ? tileRowCap : 1), 1);
+                for (int r = 0; r < tileRows; r++) memcpy(grown + (size_t)r*cap, tileType + (size_t)r*tileCap, tileCap);
+                free(tileType);
+                tileType = grown;
+                tileCap = cap;
+            }
+            if (tileRows == tileRowCap) {
+                tileRowCap = (tileRowCap > 0) ? tileRowCap*2 : 64;
+                tileType = realloc(tileType, (size_t)tileCap*tileRowCap);
+            }
+
+            unsigned char *out = tileType + (size_t)tileRows*tileCap;
+            memset(out, 0, tileCap);
+            for (int c = 0; c < n; c++) {
+                char ch = row[c];
+                if (ch == '=') out[c] = 4 + 1;
+                else if (ch >= '0' && ch <= '9') out[c] = (unsigned char)(ch - '0' + 1);
+                else if (ch == 'a') out[c] = 10 + 1;
+                else if (ch != '.') {
+                    fprintf(stderr, "%s:%d: casilla no válida '%c'\n", argv[1], lineNo, ch);
+                    errors++;
+                }
+            }
+            if (n > tileCols) tileCols = n;
+            tileRows++;
+        }
+        else if (strcmp(word, "objeto") == 0 && sscanf(line, "%*s %f %f", &x, &y) == 2) {
+            item = Push(item, &itemCount, &itemCap, sizeof(Vector2));
+            item[itemCount - 1] = (Vector2){ x, y };
+        }
+        else {
+            fprintf(stderr, "%s:%d: línea no válida: %s", argv[1], lineNo, line);
+            errors++;
+        }
+    }
+    fclose(f);
+
+    if (!hasGoal) {
+        fprintf(stderr, "%s: falta la línea 'meta'\n", argv[1]);
+        errors++;
+    }
+
+    // Casillas: compactar las filas al ancho real
+    if (hasTiles && tileRows > 0) {
+        for (int r = 1; r < tileRows; r++) memmove(tileType + (size_t)r*tileCols, tileType + (size_t)r*tileCap, tileCols);
+        tiles.cols = tileCols;
+        tiles.rows = tileRows;
+        tiles.type = tileType;
+    }
+
+    if (errors == 0 && !SaveLevelFile(argv[2], spawn, goalX, chunkWidth, box, type, platformCount,
+                                      enemy, enemyType, enemyCount, item, itemCount, &tiles)) {
+        fprintf(stderr, "levelconv: no se pudo escribir %s\n", argv[2]);
+        errors++;
+    }
+
+    if (errors == 0)
+        printf("%s: %d plataformas, %d enemigos, %d objetos, %dx%d casillas\n",
+               argv[2], platformCount, enemyCount, itemCount, tiles.cols, tiles.rows);
+
+    free(box);
+    free(type);
+    free(enemy);
+    free(enemyType);
+    free(item);
+    free(tileType);
+    return (errors == 0) ? 0 : 1;
+}
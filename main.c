@@ -7,9 +7,13 @@
 // ------------------------------
 // INCLUSIÓN DE MÓDULOS .C
 // ------------------------------
-#include "animation.c"          // Animación del jugador
-#include "enemy_sprites.c"    // Animación independiente de enemigos
+#include "gameplay.c"           // Lógica del juego (sin dibujo ni entrada)
+#include "statehash.c"          // Huella del estado por tick (repeticiones)
+#include "replay.c"             // Grabación/reproducción de comandos
+#include "snapshot.c"           // Instantáneas del estado (puntos de control)
+#include "netplay.c"            // Cooperativo por red con rollback
 #include "playercamera.c"
+#include "render.c"             // Dibujo del nivel (plataformas, enemigos, disparos...)
 
 #include "menu_sprites.c"       // Sprites del menú
 #include "music.c"              // Música del menú y juego
@@ -22,79 +26,33 @@
    
 #endif
 
-#define SCREEN_WIDTH 1024
-#define SCREEN_HEIGHT 576
-#define NUM_SHOOTS 50
-#define MAX_PLATFORMS 64
-#define MAX_ENEMIES 16
-#define MAX_COLLECTIBLES 32
+#define MAX_TICKS_PER_FRAME 8   // Tope de ticks por frame (evita la espiral de la muerte)
 
-// ------------------------------
-// Estructuras de datos
-// ------------------------------
-typedef struct Player {
-    Vector2 pos;
-    Vector2 vel;
-    Rectangle box;
-    bool onGround;
-    int lives;
-    int score;
-} Player;
-
-typedef struct Shoot {
-    Rectangle rec;
-    Vector2 speed;
-    bool active;
-    Color color;
-} Shoot;
-
-typedef struct Platform {
-    Rectangle box;
-    int type;      // 0..2 plataformas, 3 = suelo
-} Platform;
-
-typedef struct Enemy {
-    Vector2 pos;
-    Vector2 vel;
-    Rectangle box;
-    int dir;        // 1 derecha, -1 izquierda
-    bool active;
-} Enemy;
-
-typedef struct Collectible {
-    Vector2 pos;
-    Rectangle box;
-    bool taken;
-} Collectible;
-
-// ------------------------------
-// Variables Globales
-// ------------------------------
-static Player player;
-static Shoot shoot[NUM_SHOOTS] = { 0 };
-static Platform platforms[MAX_PLATFORMS];
-static Enemy enemies[MAX_ENEMIES];
-static Collectible collectibles[MAX_COLLECTIBLES];
-static int shootRate = 0;
+// Acumulador del paso fijo y entrada retenida hasta el siguiente tick
+static float simAccumulator = 0.0f;
+static InputCmd pendingCmd = { 0 };
 
-static int platformCount = 0;
-static int enemyCount = 0;
-static int collectibleCount = 0;
+// Grabación (--record archivo) y reproducción (--play archivo)
+static Replay replay = { 0 };
+static const char *recordPath = NULL;
+static bool playingReplay = false;
+static bool replayDesync = false;   // Ya se avisó de que la reproducción se desvió
 
-static Camera2D camera;
+// Punto de control: F5 lo guarda, F9 vuelve a él (reintento rápido).
+// Desactivado al grabar o reproducir: la repetición es una sola línea de tiempo.
+static GameSnapshot checkpoint = { 0 };
 
-static bool gameOver = false;
-static bool victory = false;
-static bool pauseGame = false;
+// Cooperativo por red (--net jugador puertoLocal puertoRemoto). Sin
+// repeticiones ni puntos de control: los dos equipos comparten la partida.
+static NetSession net = { 0 };
+static bool netPlay = false;
 
-const float GRAVITY = 1200.0f;
-const float MOVE_SPEED = 240.0f;
-const float JUMP_SPEED = 520.0f;
-const float SHOOT_SPEED = 800.0f;
-
-// Texturas de plataformas y suelo
-static Texture2D platformTex[3];
-static Texture2D groundTex;
+// Latencia de entrada: con VSYNC raylib lee la entrada justo antes de cada
+// frame (SetLateInputLatch), no justo después del anterior. F3 muestra la
+// medida (de la lectura de la entrada al cambio de búfer). Las dos
+// funciones son de la copia parcheada de raylib (raylib/src): solo se usan
+// si se compila con GAME_LATE_INPUT_LATCH (make RAYLIB_LATE_INPUT=TRUE).
+static bool showLatency = false;
 
 // ------------------------------
 // Menú (pantallas)
@@ -108,72 +66,10 @@ static int optionSelect = 0;
 // ------------------------------
 // Prototipos
 // ------------------------------
-Rectangle GetPlayerBox(Player *p);
-bool CheckCollisionRectangles(Rectangle a, Rectangle b);
-void AddPlatform(float x, float y, float w, float h, int type);
-void AddEnemy(float x, float y);
-void AddCollectible(float x, float y);
-void InitShoots(void);
-void ResetLevel(void);
-
-void UpdatePlayer(float dt);
-void UpdateEnemies(float dt);
-void UpdateCollectibles(void);
-void UpdateShoots(float dt);
-
 void LoadResources(void);
 void UnloadResources(void);
-
-
-// ------------------------------
-// Utilidades
-// ------------------------------
-Rectangle GetPlayerBox(Player *p) {
-    return (Rectangle){
-        p->pos.x - p->box.width/2,
-        p->pos.y - p->box.height,
-        p->box.width,
-        p->box.height
-    };
-}
-
-bool CheckCollisionRectangles(Rectangle a, Rectangle b) {
-    return !(a.x + a.width < b.x ||
-             a.x > b.x + b.width ||
-             a.y + a.height < b.y ||
-             a.y > b.y + b.height);
-}
-
-void AddPlatform(float x, float y, float w, float h, int type) {
-    platforms[platformCount].box = (Rectangle){x,y,w,h};
-    platforms[platformCount].type = type;
-    platformCount++;
-}
-
-void AddEnemy(float x, float y) {
-    enemies[enemyCount].pos = (Vector2){x,y};
-    enemies[enemyCount].vel = (Vector2){40,0};
-    enemies[enemyCount].dir = -1;
-    enemies[enemyCount].box = (Rectangle){x-16,y-32,32,32};
-    enemies[enemyCount].active = true;
-    enemyCount++;
-}
-
-void AddCollectible(float x, float y) {
-    collectibles[collectibleCount].pos = (Vector2){x,y};
-    collectibles[collectibleCount].box = (Rectangle){x-8,y-8,16,16};
-    collectibles[collectibleCount].taken = false;
-    collectibleCount++;
-}
-
-void InitShoots() {
-    for (int i=0;i<NUM_SHOOTS;i++) {
-        shoot[i].rec = (Rectangle){0,0,10,5};
-        shoot[i].speed = (Vector2){SHOOT_SPEED,0};
-        shoot[i].active = false;
-        shoot[i].color = MAROON;
-    }
-}
+void ReadInputCmd(InputCmd *cmd, bool controller);
+void RestartLevel(void);
 
 
 // ------------------------------
@@ -187,23 +83,13 @@ void LoadResources() {
     LoadMusicTracks();
     PlayMenuMusic();
 
-    platformTex[0] = LoadTexture("resources/Sprites/Plataformas/suelo.png");
-    platformTex[1] = LoadTexture("resources/Sprites/Plataformas/suelo.png");
-    platformTex[2] = LoadTexture("resources/Sprites/Plataformas/suelo.png");
-    platformTex[3] = LoadTexture("resources/Sprites/Plataformas/suelo.png");
-    platformTex[4] = LoadTexture("resources/Sprites/Plataformas/suelo.png");
-    platformTex[5] = LoadTexture("resources/Sprites/Plataformas/suelo.png");
-    platformTex[6] = LoadTexture("resources/Sprites/Plataformas/suelo.png");
-    platformTex[7] = LoadTexture("resources/Sprites/Plataformas/suelo.png");
-    platformTex[8] = LoadTexture("resources/Sprites/Plataformas/suelo.png");
-    platformTex[9] = LoadTexture("resources/Sprites/Plataformas/suelo.png");
-    platformTex[10] = LoadTexture("resources/Sprites/Plataformas/suelo.png");
-
-    //Fondo nivel
-    groundTex = LoadTexture("resources/Sprites/Plataformas/cielo.png");
+    LoadWorldTextures();
 
     LoadPlayerAnimations();
     LoadEnemyAnimations(); // ← NUEVO
+
+    // Suelos, objetos y disparos con la página del mundo: un solo lote
+    UseAtlasForShapes(idleAnim.sheet);
 }
 
 
@@ -215,388 +101,144 @@ void UnloadResources() {
     LoadEnemyAnimations();
     UnloadMusicTracks();
 
-    UnloadTexture(platformTex[0]);
-    UnloadTexture(platformTex[1]);
-    UnloadTexture(platformTex[2]);
-    UnloadTexture(platformTex[3]);
-    UnloadTexture(platformTex[4]);
-    UnloadTexture(platformTex[5]);
-    UnloadTexture(platformTex[6]);
-    UnloadTexture(platformTex[7]);
-    UnloadTexture(platformTex[8]);
-    UnloadTexture(platformTex[9]);
-    UnloadTexture(platformTex[10]);
+    UnloadWorldTextures();
 
-    UnloadTexture(groundTex);
+    UnloadLevel();
 
     UnloadPlayerSprites();
     UnloadEnemySprites(); // ← NUEVO
+    UnloadAtlas();
+    UnloadAnimDb();
 }
 
 
 // ------------------------------
-// Reset del nivel
-// ------------------------------
-void ResetLevel() {
-
-    player.pos = (Vector2){120,300};
-    player.vel = (Vector2){0,0};
-    player.box = (Rectangle){0,0,28,64};
-    player.lives = 3;
-    player.score = 0;
-    player.onGround = false;
-
-    camera.target = player.pos;
-    camera.offset = (Vector2){SCREEN_WIDTH/2, 450};
-    camera.zoom = 1.5f;
-
-    platformCount = 0;
-    enemyCount = 0;
-    collectibleCount = 0;
-
-    //suelo
-    AddPlatform(10,420,900,1600,4);
-    AddPlatform(1620,420,600,1600,4);
-    AddPlatform(2620,420,600,1600,4); 
-    AddPlatform(3920,420,600,1600,4); 
-
-    //AddPlatform(340,420,20,30,5);
-
-    //Plataformas(x,y,z,ancho,numero de plataforma)
-    AddPlatform(400,340,200,24,0);  //1
-    AddPlatform(700,280,160,24,1);  //2
-    AddPlatform(920,220,120,24,2);  //3
-    AddPlatform(1217,290,125,24,3); //4
-    AddPlatform(1520,230,120,24,5); //5
-    AddPlatform(2020,330,120,24,6); //6
-    AddPlatform(2300,250,120,24,7); //7
-    AddPlatform(3300,350,120,24,8); //8
-    AddPlatform(3500,260,120,24,9); //9
-    AddPlatform(3700,160,120,24,10); //10
-
-    //Enemigos
-    AddEnemy(1620,420);  // suelo 2
-    AddEnemy(1690,420);  // suelo 2
-    AddEnemy(2640,420);  // suelo 3
-    AddEnemy(2690,420);  // suelo 3
-    AddEnemy(3920,420);  // suelo 4
-    AddEnemy(3990,420);  // suelo 4
-    AddEnemy(780,280);   // Enemigo 1 (plataforma 2)
-    AddEnemy(980,220);   // Enemigo 2 (plataforma 3)
-    AddEnemy(1280,290);  // Enemigo 3(plataforma 4)
-
-    AddCollectible(460,300);
-    AddCollectible(730,240);
-
-    InitShoots();
-    shootRate = 0;
-
-    gameOver = false;
-    victory = false;
-    pauseGame = false;
-}
-
-
-// ------------------------------
-// Actualizar jugador
+// Leer teclado y mando en un InputCmd
 // ------------------------------
-void UpdatePlayer(float dt) {
+// El movimiento se toma del frame actual; las pulsaciones se acumulan
+// hasta que un tick las consume (puede haber frames sin ticks).
+void ReadInputCmd(InputCmd *cmd, bool controller) {
 
-    bool controller = IsGamepadAvailable(0);
+    cmd->move = 0;
 
-    float move = 0;
+    if (IsKeyDown(KEY_D)) cmd->move = 127;
+    else if (IsKeyDown(KEY_A)) cmd->move = -127;
 
-    // MOVIMIENTO → ANIMACIÓN
-    if (IsKeyDown(KEY_D)) {
-        move += 1;
-        facingRight = true;
-        playerState = PLAYER_WALK;
-    }
-    else if (IsKeyDown(KEY_A)) {
-        move -= 1;
-        facingRight = false;
-        playerState = PLAYER_WALK;
-    }
-    else {
-        playerState = PLAYER_IDLE;
-    }
-        // --- Movimiento con Gamepad ---
+    // --- Movimiento con Gamepad ---
     if (controller) {
         float axis = GetGamepadAxisMovement(0, GAMEPAD_AXIS_LEFT_X);
 
-            if (axis > 0.2f) {
-            move = 1;
-            facingRight = true;
-        }
-        else if (axis < -0.2f) {
-            move = -1;
-            facingRight = false;
-        }
-    }
-
-    // ---------------------
-    // DEFINIR ESTADO DE ANIMACIÓN
-    // ---------------------
-    if (player.lives <= 0) {
-        playerState = PLAYER_DEATH;
-    }
-    else if (move != 0) {
-        playerState = PLAYER_WALK;
-    }
-    else {
-        playerState = PLAYER_IDLE;
+        if (axis > 0.2f) cmd->move = 127;
+        else if (axis < -0.2f) cmd->move = -127;
     }
 
-    if ((IsKeyPressed(KEY_SPACE) || IsKeyPressed(KEY_Z) ||
+    if (IsKeyPressed(KEY_SPACE) || IsKeyPressed(KEY_Z) ||
         (controller && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN)))
-        && player.onGround) 
-    {
-        player.vel.y = -JUMP_SPEED;
-        player.onGround = false;
-    }
-
-
-    // Actualizar animación según estado
-    switch (playerState) {
-        case PLAYER_IDLE:  UpdateAnimation(&idleAnim, dt);  break;
-        case PLAYER_WALK:  UpdateAnimation(&walkAnim, dt);  break;
-        case PLAYER_DEATH: UpdateAnimation(&deathAnim, dt); break;
-    }
-
-    player.vel.x = move * MOVE_SPEED;
-
-     // Si muere
-    if (player.lives <= 0 && playerState != PLAYER_DEATH) {
-        playerState = PLAYER_DEATH;
-        ResetAnimation(&deathAnim);
-    }
+        cmd->buttons |= INPUT_JUMP;
 
-      // Disparar
     if (IsKeyPressed(KEY_RIGHT) ||
         (controller && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_RIGHT)))
-    {
-        for (int i=0;i<NUM_SHOOTS;i++) {
-            if (!shoot[i].active) {
-                Rectangle box = GetPlayerBox(&player);
-                shoot[i].rec.x = box.x + box.width;
-                shoot[i].rec.y = box.y + box.height/2;
-                shoot[i].active = true;
-                break;
-            }
-        }
-    } else shootRate = 0;
-    
-
-    // FÍSICAS
-    player.vel.y += GRAVITY * dt;
-    player.pos.x += player.vel.x * dt;
-    player.pos.y += player.vel.y * dt;
-
-    player.box = GetPlayerBox(&player);
-    player.onGround = false;
-
-    // COLISIONES
-    for (int i=0;i<platformCount;i++) {
-
-        Rectangle p = platforms[i].box;
-
-        if (CheckCollisionRectangles(player.box, p)) {
-            float prevY = player.pos.y - player.vel.y * dt;
-
-            if (prevY <= p.y) {
-                player.pos.y = p.y;
-                player.vel.y = 0;
-                player.onGround = true;
-            }
-        }
-    }
+        cmd->buttons |= INPUT_SHOOT;
 
-    // Caer al vacío
-    if (player.pos.y > 1400) {
-        player.lives--;
-        player.pos = (Vector2){120,300};
-    }
-
-    if (player.lives <= 0) {
-        gameOver = true;
-    }
-    
-    // GAME OVER al terminar animación de muerte
-    if (player.lives <= 0) {
-        playerState = PLAYER_DEATH;
+    if (IsKeyPressed(KEY_P) || (controller && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_MIDDLE_RIGHT)))
+        cmd->buttons |= INPUT_PAUSE;
 
-        if (IsAnimationFinished(&deathAnim)) {
-            gameOver = true;
-        }
-    }
+    if (IsKeyPressed(KEY_R) || (controller && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_LEFT)))
+        cmd->buttons |= INPUT_RESET;
 }
 
 
 // ------------------------------
-// Actualizar enemigos (MOVIMIENTO + ANIMACIÓN)
+// Reiniciar nivel y reloj de simulación
 // ------------------------------
-void UpdateEnemies(float dt) {
-
-    UpdateAllEnemyAnimations(dt); // ← animaciones
-
-    for (int i = 0; i < enemyCount; i++) {
-        Enemy *e = &enemies[i];
-        if (!e->active) continue;
-
-        // velocidad horizontal prevista
-        float stepX = e->vel.x * e->dir * dt;
-        float nextX = e->pos.x + stepX;
-
-        // actualizar caja según pos actual (antes de mover)
-        e->box.x = e->pos.x - e->box.width / 2.0f;
-        e->box.y = e->pos.y - e->box.height;
-
-        // Buscar la plataforma actual (si existe) en la que está apoyado el enemigo
-        int currentPlat = -1;
-        for (int j = 0; j < platformCount; j++) {
-            Rectangle pb = platforms[j].box;
-            // Consideramos que el enemigo está "sobre" la plataforma si su X está dentro
-            // y su Y está cerca de la Y de la plataforma.
-            if (e->pos.x >= pb.x && e->pos.x <= pb.x + pb.width) {
-                float dy = e->pos.y - pb.y;
-                if (dy >= -8.0f && dy <= 48.0f) { // tolerancia vertical razonable
-                    currentPlat = j;
-                    break;
-                }
-            }
-        }
+void RestartLevel() {
+    // En red el nivel solo se reinicia con INPUT_RESET, que va en los
+    // comandos compartidos: volver del menú no puede reiniciarlo en un solo equipo
+    if (netPlay) return;
 
-        // Si está sobre una plataforma, fijar su Y a la plataforma (evita desalineaciones)
-        if (currentPlat >= 0) {
-            Rectangle pb = platforms[currentPlat].box;
-            e->pos.y = pb.y;
-            e->box.y = e->pos.y - e->box.height;
-        }
-
-        // Decidir si avanzar o girar:
-        bool shouldTurn = false;
-
-        if (currentPlat >= 0) {
-            // Si avanza, ¿se saldría del ancho de la plataforma?
-            Rectangle pb = platforms[currentPlat].box;
-            float projectedFeetX = nextX; // usamos la X del "centro" del enemigo
-            // margen para evitar "pegado" al borde:
-            const float EDGE_MARGIN = 6.0f;
-
-            if (projectedFeetX < pb.x + EDGE_MARGIN || projectedFeetX > pb.x + pb.width - EDGE_MARGIN) {
-                shouldTurn = true;
-            } else {
-                // además comprobamos colisiones laterales con el "volumen" de la plataforma (paredes)
-                Rectangle nextBox = e->box;
-                nextBox.x = nextX - e->box.width / 2.0f;
-
-                // pared izquierda
-                if (CheckCollisionRectangles(nextBox, (Rectangle){pb.x - 2.0f, pb.y - pb.height, 2.0f, pb.height})) {
-                    shouldTurn = true;
-                }
-                // pared derecha
-                if (CheckCollisionRectangles(nextBox, (Rectangle){pb.x + pb.width, pb.y - pb.height, 2.0f, pb.height})) {
-                    shouldTurn = true;
-                }
-            }
-        } else {
-            // Si no está sobre ninguna plataforma: buscar si hay plataforma justo delante (paso en vacío)
-            bool platformAhead = false;
-            for (int j = 0; j < platformCount; j++) {
-                Rectangle pb = platforms[j].box;
-                // ver si la X prevista cae dentro de alguna plataforma y la Y es coherente
-                if (nextX >= pb.x && nextX <= pb.x + pb.width) {
-                    float dy = e->pos.y - pb.y;
-                    if (dy >= -16.0f && dy <= 48.0f) {
-                        platformAhead = true;
-                        break;
-                    }
-                }
-            }
-            // si no hay plataforma adelante, girar
-            if (!platformAhead) shouldTurn = true;
-        }
+    ResetLevel();
+    simAccumulator = 0.0f;
+    pendingCmd = (InputCmd){ 0 };
 
-        if (shouldTurn) {
-            e->dir *= -1;
-            // ajustar posición para evitar quedar 'pegado' fuera del borde
-            e->pos.x += e->vel.x * e->dir * dt;
-        } else {
-            // avanzar
-            e->pos.x = nextX;
-        }
+    // Reserva la instantánea para este nivel (y olvida el punto de control anterior)
+    InitSnapshot(&checkpoint);
 
-        // actualizar caja final
-        e->box.x = e->pos.x - e->box.width / 2.0f;
-        e->box.y = e->pos.y - e->box.height;
-
-        // Colisión con jugador
-        if (CheckCollisionRectangles(e->box, GetPlayerBox(&player))) {
-            if (player.vel.y > 200.0f) {
-                // jugador salta encima -> enemigo muere
-                e->active = false;
-                player.vel.y = -JUMP_SPEED * 0.4f;
-                player.score += 100;
-            } else {
-                // daño al jugador
-                player.lives--;
-                player.pos = (Vector2){120,300};
-                player.vel = (Vector2){0,0};
-            }
-        }
-    }
+    // La grabación empieza en cada inicio de nivel desde el menú
+    if (recordPath != NULL) ClearReplay(&replay);
 }
 
 
-
-
 // ------------------------------
-// Actualizar objetos
+// MAIN
 // ------------------------------
-void UpdateCollectibles() {
-    for (int i=0;i<collectibleCount;i++) {
-        if (!collectibles[i].taken &&
-            CheckCollisionRectangles(collectibles[i].box, GetPlayerBox(&player))) {
-            collectibles[i].taken = true;
-            player.score += 50;
+int main(int argc, char **argv) {
+
+    // Opciones: --record archivo (grabar partida), --play archivo (reproducir),
+    // --net jugador puertoLocal puertoRemoto [--net-delay ms] [--net-jitter ms]
+    // [--net-loss pct] (cooperativo en este equipo, p. ej. "--net 0 7000 7001"
+    // en una ventana y "--net 1 7001 7000" en otra), --level archivo.lvl
+    const char *playPath = NULL;
+    int netIndex = -1, localPort = 0, remotePort = 0;
+    int netDelay = 0, netJitter = 0, netLoss = 0;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--record") == 0) recordPath = argv[++i];
+        else if (strcmp(argv[i], "--play") == 0) playPath = argv[++i];
+        else if (strcmp(argv[i], "--net") == 0 && i + 3 < argc) {
+            netIndex = (atoi(argv[++i]) != 0);
+            localPort = atoi(argv[++i]);
+            remotePort = atoi(argv[++i]);
         }
+        else if (strcmp(argv[i], "--net-delay") == 0) netDelay = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--net-jitter") == 0) netJitter = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--net-loss") == 0) netLoss = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--level") == 0) levelPath = argv[++i];
     }
-}
-
-
-// ------------------------------
-// Disparos
-// ------------------------------
-void UpdateShoots(float dt) {
-    for (int i=0;i<NUM_SHOOTS;i++) {
-        if (!shoot[i].active) continue;
-
-        shoot[i].rec.x += SHOOT_SPEED * dt;
-
-        for (int e=0;e<enemyCount;e++) {
-            if (!enemies[e].active) continue;
 
-            if (CheckCollisionRectangles(shoot[i].rec, enemies[e].box)) {
-                enemies[e].active = false;
-                shoot[i].active = false;
-                player.score += 100;
-            }
-        }
+    if (netIndex >= 0) {
+        SetPlayerCount(2);
+        localPlayer = netIndex;
     }
-}
-
-
-
-// ------------------------------
-// MAIN
-// ------------------------------
-int main(void) {
 
+    // VSYNC solo con la lectura tardía: con la raylib normal EndDrawing
+    // esperaría al retrazo y leería la entrada justo después, casi un
+    // refresco entero antes de mostrarla (más latencia que sin VSYNC)
+#if defined(GAME_LATE_INPUT_LATCH)
+    SetConfigFlags(FLAG_VSYNC_HINT);
+#endif
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Dragon Legends");
     SetTargetFPS(60);
+#if defined(GAME_LATE_INPUT_LATCH)
+    SetLateInputLatch(true);
+#endif
 
     LoadResources();
-    ResetLevel();
+    RestartLevel();
+
+    if (netIndex >= 0) {
+        if (StartNetSession(&net, netIndex, localPort, remotePort)) {
+            SetNetShim(&net, netDelay, netJitter, netLoss);
+            netPlay = true;
+            recordPath = NULL;
+            playPath = NULL;
+            currentScreen = GAMEPLAY;
+            PlayGameMusic();
+        }
+        else {
+            TraceLog(LOG_WARNING, "No se pudo abrir la partida en red (puerto %d)", localPort);
+            SetPlayerCount(1);
+            RestartLevel();
+        }
+    }
+
+    if (playPath != NULL) {
+        if (LoadReplay(&replay, playPath)) {
+            playingReplay = true;
+            recordPath = NULL;
+            currentScreen = GAMEPLAY;
+            PlayGameMusic();
+        }
+        else TraceLog(LOG_WARNING, "No se pudo cargar la repetición: %s", playPath);
+    }
 
     while (!WindowShouldClose()) {
 
@@ -635,7 +277,7 @@ int main(void) {
             {
 
                 if (optionSelect == 0) {
-                    ResetLevel();  
+                    RestartLevel();
                     currentScreen = GAMEPLAY;
                     PlayGameMusic();
                 }
@@ -656,32 +298,29 @@ int main(void) {
             // Logo
             float escala = 0.45f;   // Ajusta este valor si lo quieres más grande o pequeño
 
-            int logoAncho = texLogo.width * escala;
-            int logoAlto  = texLogo.height * escala;
+            int logoAncho = texLogo.rec.width * escala;
+            int logoAlto  = texLogo.rec.height * escala;
 
             int posX = (SCREEN_WIDTH - logoAncho) / 2;
             int posY = -60;
 
-            DrawTexturePro(
+            DrawSpritePro(
                 texLogo,
-                (Rectangle){ 0, 0, texLogo.width, texLogo.height },    // origen
                 (Rectangle){ posX, posY, logoAncho, logoAlto },        // destino escalado
-                (Vector2){ 0, 0 },
-                0.0f,
                 WHITE
             );
 
             // Botones
-            int bx = SCREEN_WIDTH/2 - texButtonIdle.width/7;
+            int bx = SCREEN_WIDTH/2 - texButtonIdle.rec.width/7;
             int by = 310;
 
             for (int i=0;i<4;i++) {
 
-                Texture2D *btn = (i==optionSelect)
+                Sprite *btn = (i==optionSelect)
                     ? &texButtonSelected
                     : &texButtonIdle;
 
-                DrawTexture(*btn, bx, by + i*60, WHITE);
+                DrawSprite(*btn, bx, by + i*60, WHITE);
 
                 const char *label =
                     (i==0) ? "JUGAR" :
@@ -712,7 +351,7 @@ int main(void) {
             ClearBackground(RAYWHITE);
             DrawText("CONTROLES", 420, 80, 40, DARKBLUE);
             DrawText("Controles Mando: joysticks(Movimiento), B/0(Disparo), \nA/X(Saltar), =(Pausa), X/O(Reiniciar Nivel), Boton Vista(Menu)", 150, 180, 24, BLACK);
-            DrawText("Controles Teclado: A(Izquierda), D(Derecha), ->(Disparo), \nSPACE(Saltar), P(pausa), R(Reiniciar Nivel), Tab(Menu)", 150, 280, 24, BLACK);
+            DrawText("Controles Teclado: A(Izquierda), D(Derecha), ->(Disparo), \nSPACE(Saltar), P(pausa), R(Reiniciar Nivel), Tab(Menu), \nF5(Punto de control), F9(Volver al punto de control)", 150, 280, 24, BLACK);
             if (controller){
             DrawText("Presiona A/X para continuar", SCREEN_WIDTH/2 - 220, 510, 20, GREEN);
             DrawText("Presiona B/0 para continuar", SCREEN_WIDTH/2 - 220, 540, 20, RED);
@@ -764,20 +403,60 @@ int main(void) {
 
             bool controller = IsGamepadAvailable(0);
 
-            if (IsKeyPressed(KEY_P) || (controller && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_MIDDLE_RIGHT)))
-            {
-                pauseGame = !pauseGame;
+            // Entrada: movimiento, salto, disparo, pausa y reinicio van en el comando del tick
+            ReadInputCmd(&pendingCmd, controller);
+            if (IsKeyPressed(KEY_F3)) showLatency = !showLatency;
+
+            if (!playingReplay && recordPath == NULL && !netPlay) {
+                if (IsKeyPressed(KEY_F5) && !gameOver) SaveSnapshot(&checkpoint);
+
+                if (IsKeyPressed(KEY_F9) && RestoreSnapshot(&checkpoint)) {
+                    simAccumulator = 0.0f;
+                    pendingCmd = (InputCmd){ 0 };
+                }
             }
 
-            if (IsKeyPressed(KEY_R)|| (controller && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_LEFT))) ResetLevel();
-            
+            // SIMULACIÓN A PASO FIJO: 0..N ticks por frame según el tiempo acumulado
+            simAccumulator += dt;
+
+            int ticks = 0;
+            while (simAccumulator >= SIM_DT && ticks < MAX_TICKS_PER_FRAME) {
+
+                InputCmd cmd = pendingCmd;
+
+                // Reproducción: el comando sale del archivo; al acabarse vuelve el control
+                if (playingReplay && !NextReplayCmd(&replay, &cmd)) playingReplay = false;
+                if (recordPath != NULL) AppendReplay(&replay, cmd);
+
+                // En red el tick espera si el otro va demasiado atrás: la
+                // entrada se queda pendiente y se reintenta el siguiente frame
+                if (netPlay) {
+                    if (!NetTick(&net, cmd)) {
+                        simAccumulator = fminf(simAccumulator, SIM_DT);
+                        break;
+                    }
+                }
+                else GameTick(&cmd);
+
+                // Huella del tick: se guarda al grabar y se compara al reproducir
+                if (recordPath != NULL) RecordReplayHash(&replay, HashGameState());
+                else if (playingReplay && !CheckReplayHash(&replay, HashGameState()) && !replayDesync) {
+                    TraceLog(LOG_WARNING, "La repetición se desvió de la grabación antes del tick %d", replay.cursor);
+                    replayDesync = true;
+                }
 
-            if (!pauseGame && !gameOver && !victory) {
-                UpdatePlayer(dt);
-                UpdateEnemies(dt);
-                UpdateCollectibles();
-                UpdateShoots(dt);
+                simAccumulator -= SIM_DT;
+                ticks++;
+
+                // Cada pulsación se consume en un único tick
+                pendingCmd.buttons = 0;
             }
+
+            // Si el equipo no da abasto se descarta el tiempo sobrante
+            if (ticks == MAX_TICKS_PER_FRAME) simAccumulator = 0.0f;
+
+            // Sin ticks este frame: recibir igualmente (y corregir lo predicho)
+            if (netPlay && ticks == 0) UpdateNetSession(&net);
             if (IsKeyPressed(KEY_TAB)|| (controller && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_MIDDLE_LEFT)))
             {
                 currentScreen = TITLE;
@@ -803,11 +482,12 @@ int main(void) {
                 DrawText("Reiniciar - Presiona R para continuar", SCREEN_WIDTH/2 - 220, SCREEN_HEIGHT/2 - 10, 20, WHITE);
                 DrawText("ENTER para regresar al menu", 360, 500, 20, GRAY);
                 }
+                if (checkpoint.size > 0 && !playingReplay && recordPath == NULL && !netPlay)
+                DrawText("F9 - Volver al punto de control", SCREEN_WIDTH/2 - 220, SCREEN_HEIGHT/2 + 20, 20, WHITE);
                 if (IsKeyPressed(KEY_ENTER)|| (controller && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_MIDDLE_RIGHT)))
                 {
                     currentScreen = TITLE;
                 }
-                if (IsKeyPressed(KEY_R)|| (controller && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_LEFT))) ResetLevel();
                 EndDrawing();
                 continue;
             }
@@ -866,11 +546,14 @@ int main(void) {
                 EndDrawing();
                 continue;
             }
-            // WIN CONDITION
-            if (player.pos.x >= 4300 && !victory)
-            victory = true;
+            // Fracción de tick pendiente: se dibuja entre los dos últimos estados
+            float alpha = simAccumulator / SIM_DT;
+            Player *me = &players[localPlayer];
+            Vector2 playerDrawPos = InterpolatePos(me->prevPos, me->pos, alpha);
 
-            UpdatePlayerCamera(&camera, player.pos);
+            UpdatePlayerCamera(&camera, playerDrawPos);
+            SyncPlatformTextures();
+            UpdateScorePopups(dt);
 
 
             BeginDrawing();
@@ -878,69 +561,29 @@ int main(void) {
 
             BeginMode2D(camera);
 
-        
+            DrawWorld(alpha);
 
-            // Plataformas
-            for (int i=0;i<platformCount;i++) {
-
-                Rectangle b = platforms[i].box;
-
-                if (platforms[i].type == 11) {
-                    DrawTexturePro(
-                        groundTex,
-                        (Rectangle){0,0, groundTex.width, groundTex.height},
-                        (Rectangle){b.x, b.y - b.height, b.width, b.height},
-                        (Vector2){0,0}, 0, WHITE
-                    );
-                }
-                else {
-                    Texture2D *t = &platformTex[platforms[i].type];
-
-                    DrawTexturePro(
-                        *t,
-                        (Rectangle){0,0,t->width,t->height},
-                        (Rectangle){b.x, b.y - b.height/3, b.width, b.height},
-                        (Vector2){0,0}, 0, WHITE
-                    );
-                }
-            }
-            //Suelos
-            DrawRectangle(10,420,900,1600,BROWN);
-            DrawRectangle(1620,420,600,1600,BROWN);
-            DrawRectangle(2620,420,600,1600,BROWN);
-            DrawRectangle(3920,420,600,1600,BROWN);
-
-
-            // ------------------------------
-            // DIBUJAR ENEMIGOS ANIMADOS
-            // ------------------------------
-            for (int i=0;i<enemyCount;i++) {
-                if (!enemies[i].active) continue;
+            EndMode2D();
 
-                DrawEnemyAnimation(enemies[i].pos, enemies[i].dir, 1); // 1 = caminar
+            DrawText(TextFormat("Vidas: %d", me->lives), 20, 20, 24, BLACK);
+            DrawText(TextFormat("Puntaje: %d", me->score), 20, 60, 24, BLACK);
+            if (playerCount > 1) {
+                const Player *mate = &players[1 - localPlayer];
+                DrawText(TextFormat("Compañero - Vidas: %d  Puntaje: %d", mate->lives, mate->score), 20, 100, 20, DARKGRAY);
             }
-
-            // Coleccionables
-            for (int i=0;i<collectibleCount;i++) {
-                if (!collectibles[i].taken)
-                    DrawCircleV(collectibles[i].pos, 8, GOLD);
+            if (netPlay) {
+                DrawText(TextFormat("Rollback: %d ticks (máx. %d)", net.tick - net.remoteConfirmed, net.stats.maxRollback),
+                         20, 130, 20, DARKGRAY);
+                if (net.stats.desyncs > 0)
+                    DrawText(TextFormat("Desincronizado entre los ticks %d y %d", net.stats.agreedTicks, net.stats.desyncTick), 20, 190, 20, RED);
             }
-
-            // Proyectiles
-            for (int i=0;i<NUM_SHOOTS;i++)
-                if (shoot[i].active)
-                    DrawRectangleRec(shoot[i].rec, MAROON);
-
-            // Jugador
-            DrawPlayer(player.pos);
-
-            DrawRectangle(4300, 0, 8, 800, GREEN);
-            DrawText("META", 4290, -20, 20, BLACK);
-
-            EndMode2D();
-
-            DrawText(TextFormat("Vidas: %d", player.lives), 20, 20, 24, BLACK);
-            DrawText(TextFormat("Puntaje: %d", player.score), 20, 60, 24, BLACK);
+#if defined(GAME_LATE_INPUT_LATCH)
+            if (showLatency)
+                DrawText(TextFormat("Latencia entrada: %.1f ms", GetInputLatency()*1000.0f), 20, 160, 20, DARKGRAY);
+#else
+            if (showLatency)
+                DrawText("Latencia entrada: no disponible (raylib sin parchear)", 20, 160, 20, DARKGRAY);
+#endif
             if (controller){
             DrawText("Mando conectado", 20, 520, 20, DARKGREEN);
             }
@@ -953,6 +596,12 @@ int main(void) {
         }
     }
 
+    if (recordPath != NULL && !SaveReplay(&replay, recordPath))
+        TraceLog(LOG_WARNING, "No se pudo guardar la repetición: %s", recordPath);
+    FreeReplay(&replay);
+    FreeSnapshot(&checkpoint);
+    if (netPlay) CloseNetSession(&net);
+
     UnloadResources();
     CloseWindow();
     return 0;
@@ -0,0 +1,442 @@
+// netplay.c
+// Cooperativo a dos jugadores por red con predicción y rollback
+// -----------------------------------
+// Cada equipo simula la partida completa. En cada tick pone su propia
+// entrada y, si la del otro aún no ha llegado, la predice (repite su último
+// movimiento confirmado, sin botones). Cuando llega la entrada real de un
+// tick ya simulado y no coincide con la predicha, se vuelve a la instantánea
+// de ese tick (snapshot.c) y se resimulan los ticks hasta el actual. Como la
+// simulación es determinista (un InputCmd por jugador y tick), los dos
+// equipos acaban en el mismo estado.
+//
+// Para comprobarlo, las huellas (statehash.c) de los ticks definitivos (ya
+// simulados con las entradas reales de los dos, no se van a rehacer) se
+// encadenan igual que en headless, y cada paquete lleva la cadena hasta el
+// último. Si no coincide con la propia hasta ese tick, los equipos se han
+// desincronizado en algún tick desde la última comparación buena
+// (stats.desyncs). Al ser encadenada, una desviación en cualquier tick se
+// ve en todas las comparaciones siguientes. La huella final es la misma
+// que con "--players 2".
+//
+// Transporte: UDP en 127.0.0.1 (dos ventanas o dos procesos en el mismo
+// equipo). Cada paquete lleva todas las entradas locales que el otro aún
+// no ha confirmado, así que una pérdida se cubre con el paquete siguiente
+// sin reenvíos ni temporizadores.
+//
+// Paquete (little endian):
+//   "PNET", ack (u32: entradas del otro recibidas seguidas),
+//   inicio (u32: tick de la primera entrada), n (u8),
+//   definitivos (u32: ticks definitivos; 0 = aún ninguno),
+//   huella (u32: encadenada hasta el tick definitivos - 1), n x (move i8, buttons u8)
+//
+// Para probar con mala red, NetShim retiene los paquetes salientes un
+// retardo (más una variación al azar) y descarta un porcentaje.
+//
+// Se incluye después de gameplay.c, statehash.c, replay.c (PutU32/GetU32) y
+// snapshot.c.
+// Toda la memoria se reserva al empezar la sesión: el rollback solo copia
+// instantáneas y llama a GameTick.
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN     // Evita choques de nombres con raylib
+    #define NOGDI
+    #define NOUSER
+    #include <winsock2.h>
+    typedef SOCKET NetSocketHandle;
+    #define NET_INVALID_SOCKET INVALID_SOCKET
+#else
+    #include <sys/socket.h>
+    #include <netinet/in.h>
+    #include <arpa/inet.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    typedef int NetSocketHandle;
+    #define NET_INVALID_SOCKET (-1)
+#endif
+
+#include <stdio.h>
+#include <string.h>
+
+#define NET_MAX_ROLLBACK    10      // Ticks por delante de la última entrada remota confirmada
+#define NET_SNAPSHOTS       (NET_MAX_ROLLBACK + 1)
+#define NET_HISTORY         64      // Entradas guardadas por jugador (potencia de 2)
+#define NET_MAX_SEND        48      // Entradas por paquete como mucho
+#define NET_HEADER_SIZE     21
+#define NET_PACKET_MAX      (NET_HEADER_SIZE + 2*NET_MAX_SEND)
+#define NET_SHIM_SLOTS      256     // Paquetes retenidos por el simulador de red
+
+// ------------------------------
+// Simulador de red: retardo, variación y pérdida de los paquetes salientes
+// ------------------------------
+typedef struct NetDelayed {
+    long long due;                  // Momento de envío (ns); 0 = hueco libre
+    int size;
+    unsigned char data[NET_PACKET_MAX];
+} NetDelayed;
+
+typedef struct NetShim {
+    int delayMs;
+    int jitterMs;
+    int lossPercent;
+    unsigned int seed;
+    NetDelayed queue[NET_SHIM_SLOTS];
+} NetShim;
+
+// ------------------------------
+// Estadísticas de la sesión
+// ------------------------------
+typedef struct NetStats {
+    long long rollbacks;            // Veces que se volvió atrás
+    long long resimulated;          // Ticks resimulados en total
+    int maxRollback;                // Rollback más largo (ticks)
+    long long maxRollbackNs;        // Rollback más lento (restaurar + resimular)
+    long long stalls;               // Llamadas a NetTick que tuvieron que esperar
+    long long packetsSent, packetsLost, packetsReceived;
+    long long desyncs;              // Comparaciones con huella distinta de la del otro
+    int agreedTicks;                // Ticks definitivos con la misma huella en los dos
+    int desyncTick;                 // Primer tick comparado con huella distinta (-1 = ninguno)
+} NetStats;
+
+typedef struct NetSession {
+    NetSocketHandle sock;
+    struct sockaddr_in remoteAddr;
+    NetShim shim;
+
+    int local, remote;              // Índice de cada jugador
+    int tick;                       // Siguiente tick a simular
+    int remoteConfirmed;            // Entradas remotas recibidas seguidas (ticks < esto)
+    int remoteAck;                  // Entradas locales que el otro ya tiene
+    int rollbackFrom;               // Primer tick mal predicho (INT_MAX = ninguno)
+    InputCmd lastRemote;            // Última entrada remota confirmada (para predecir)
+    int finalTicks;                 // Ticks definitivos (ya encadenados en chain)
+    uint32_t chain;                 // Huellas encadenadas de los ticks definitivos
+
+    InputCmd inputs[NET_HISTORY][MAX_PLAYERS];  // Entrada usada en cada tick
+    uint32_t hashes[NET_HISTORY];               // Huella del estado tras cada tick
+    uint32_t chains[NET_HISTORY];               // chain tras cada tick definitivo
+    GameSnapshot snapshots[NET_SNAPSHOTS];      // Estado antes de cada tick
+
+    NetStats stats;
+    bool active;
+} NetSession;
+
+// ------------------------------
+// Prototipos
+// ------------------------------
+bool StartNetSession(NetSession *s, int localIndex, int localPort, int remotePort);
+void SetNetShim(NetSession *s, int delayMs, int jitterMs, int lossPercent);
+void UpdateNetSession(NetSession *s);
+bool NetTick(NetSession *s, InputCmd localCmd);
+void CloseNetSession(NetSession *s);
+void NetIdle(void);
+
+
+// Número al azar para el simulador (no toca el rand() de nadie)
+static unsigned int NetRand(NetShim *shim) {
+    shim->seed = shim->seed*1103515245u + 12345u;
+    return shim->seed >> 16;
+}
+
+static void NetSendNow(NetSession *s, const unsigned char *data, int size) {
+    sendto(s->sock, (const char *)data, size, 0, (const struct sockaddr *)&s->remoteAddr, sizeof(s->remoteAddr));
+}
+
+// Envía (o retiene en el simulador) un paquete
+static void NetSend(NetSession *s, const unsigned char *data, int size) {
+    NetShim *shim = &s->shim;
+    s->stats.packetsSent++;
+
+    if (shim->lossPercent > 0 && (int)(NetRand(shim) % 100) < shim->lossPercent) {
+        s->stats.packetsLost++;
+        return;
+    }
+    if (shim->delayMs <= 0 && shim->jitterMs <= 0) {
+        NetSendNow(s, data, size);
+        return;
+    }
+
+    long long delayNs = (long long)shim->delayMs*1000000LL;
+    if (shim->jitterMs > 0) delayNs += (long long)(NetRand(shim) % (unsigned int)(shim->jitterMs + 1))*1000000LL;
+
+    for (int i = 0; i < NET_SHIM_SLOTS; i++) {
+        NetDelayed *d = &shim->queue[i];
+        if (d->due != 0) continue;
+        d->due = NowNs() + delayNs;
+        d->size = size;
+        memcpy(d->data, data, size);
+        return;
+    }
+    s->stats.packetsLost++;         // Cola llena: como una pérdida
+}
+
+// Envía los paquetes retenidos cuyo retardo ya pasó (con variación pueden
+// salir desordenados, igual que en una red real)
+static void FlushNetShim(NetSession *s) {
+    long long now = NowNs();
+    for (int i = 0; i < NET_SHIM_SLOTS; i++) {
+        NetDelayed *d = &s->shim.queue[i];
+        if (d->due == 0 || d->due > now) continue;
+        NetSendNow(s, d->data, d->size);
+        d->due = 0;
+    }
+}
+
+
+// ------------------------------
+// Abrir la sesión: socket local, dirección del otro y estado inicial.
+// Llamar después de SetPlayerCount(2) y ResetLevel (reserva las instantáneas
+// para el nivel cargado).
+// ------------------------------
+bool StartNetSession(NetSession *s, int localIndex, int localPort, int remotePort) {
+
+    *s = (NetSession){ 0 };
+    s->sock = NET_INVALID_SOCKET;
+
+#if defined(_WIN32)
+    WSADATA wsa;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) return false;
+#endif
+
+    s->sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (s->sock == NET_INVALID_SOCKET) return false;
+
+    struct sockaddr_in addr = { 0 };
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons((unsigned short)localPort);
+
+    if (bind(s->sock, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        fprintf(stderr, "netplay: no se pudo usar el puerto %d\n", localPort);
+        CloseNetSession(s);
+        return false;
+    }
+
+    // Sin bloqueo: se leen los paquetes que haya y se sigue
+#if defined(_WIN32)
+    u_long nonBlocking = 1;
+    ioctlsocket(s->sock, FIONBIO, &nonBlocking);
+#else
+    fcntl(s->sock, F_SETFL, fcntl(s->sock, F_GETFL, 0) | O_NONBLOCK);
+#endif
+
+    s->remoteAddr = addr;
+    s->remoteAddr.sin_port = htons((unsigned short)remotePort);
+
+    s->local = localIndex;
+    s->remote = 1 - localIndex;
+    s->rollbackFrom = INT_MAX;
+    s->stats.desyncTick = -1;
+    s->shim.seed = 0x2545f491u + (unsigned int)localIndex;
+
+    for (int i = 0; i < NET_SNAPSHOTS; i++) InitSnapshot(&s->snapshots[i]);
+
+    s->active = true;
+    return true;
+}
+
+void SetNetShim(NetSession *s, int delayMs, int jitterMs, int lossPercent) {
+    s->shim.delayMs = delayMs;
+    s->shim.jitterMs = jitterMs;
+    s->shim.lossPercent = lossPercent;
+}
+
+// Entrada remota supuesta: sigue moviéndose igual, sin pulsar nada
+static InputCmd PredictRemote(const NetSession *s) {
+    return (InputCmd){ s->lastRemote.move, 0 };
+}
+
+// Encadena las huellas de los ticks que ya no pueden cambiar: simulados,
+// con la entrada remota confirmada y sin rollback pendiente
+static void FinalizeNetTicks(NetSession *s) {
+    int limit = s->tick < s->remoteConfirmed ? s->tick : s->remoteConfirmed;
+    if (s->rollbackFrom < limit) limit = s->rollbackFrom;
+
+    for (; s->finalTicks < limit; s->finalTicks++) {
+        s->chain = ChainStateHash(s->chain, s->hashes[s->finalTicks & (NET_HISTORY - 1)]);
+        s->chains[s->finalTicks & (NET_HISTORY - 1)] = s->chain;
+    }
+}
+
+// Compara la cadena de huellas del otro con la propia hasta el mismo tick
+// (si aquí ya es definitivo y aún se guarda)
+static void CheckNetHash(NetSession *s, int finalTicks, uint32_t chain) {
+    int t = finalTicks - 1;
+    if (t < 0 || finalTicks > s->finalTicks || s->finalTicks - finalTicks >= NET_HISTORY) return;
+
+    if (s->chains[t & (NET_HISTORY - 1)] == chain) {
+        if (finalTicks > s->stats.agreedTicks) s->stats.agreedTicks = finalTicks;
+        return;
+    }
+    if (s->stats.desyncs == 0) {
+        fprintf(stderr, "netplay: el estado del otro jugador se desvió entre los ticks %d y %d\n",
+                s->stats.agreedTicks, t);
+        s->stats.desyncTick = t;
+    }
+    s->stats.desyncs++;
+}
+
+// ------------------------------
+// Paquetes
+// ------------------------------
+static void SendNetInputs(NetSession *s) {
+    unsigned char packet[NET_PACKET_MAX];
+
+    FinalizeNetTicks(s);
+
+    int start = s->remoteAck;
+    int count = s->tick - start;
+    if (count > NET_MAX_SEND) count = NET_MAX_SEND;
+
+    memcpy(packet, "PNET", 4);
+    PutU32(packet + 4, (unsigned int)s->remoteConfirmed);
+    PutU32(packet + 8, (unsigned int)start);
+    packet[12] = (unsigned char)count;
+    PutU32(packet + 13, (unsigned int)s->finalTicks);
+    PutU32(packet + 17, s->chain);
+
+    for (int k = 0; k < count; k++) {
+        const InputCmd *cmd = &s->inputs[(start + k) & (NET_HISTORY - 1)][s->local];
+        packet[NET_HEADER_SIZE + 2*k] = (unsigned char)cmd->move;
+        packet[NET_HEADER_SIZE + 2*k + 1] = cmd->buttons;
+    }
+
+    NetSend(s, packet, NET_HEADER_SIZE + 2*count);
+}
+
+static void ReceiveNetInputs(NetSession *s) {
+    unsigned char packet[NET_PACKET_MAX];
+
+    for (;;) {
+        int size = (int)recvfrom(s->sock, (char *)packet, sizeof(packet), 0, NULL, NULL);
+        if (size < NET_HEADER_SIZE) {
+            if (size < 0) return;   // No hay más (o error): se vuelve a mirar el siguiente frame
+            continue;
+        }
+        if (memcmp(packet, "PNET", 4) != 0) continue;
+
+        int count = packet[12];
+        if (size < NET_HEADER_SIZE + 2*count) continue;
+        s->stats.packetsReceived++;
+
+        int ack = (int)GetU32(packet + 4);
+        int start = (int)GetU32(packet + 8);
+        if (ack > s->remoteAck && ack <= s->tick) s->remoteAck = ack;
+        CheckNetHash(s, (int)GetU32(packet + 13), GetU32(packet + 17));
+
+        // Solo valen las entradas que continúan la serie confirmada
+        for (int k = 0; k < count; k++) {
+            int t = start + k;
+            if (t < s->remoteConfirmed) continue;
+            if (t > s->remoteConfirmed || t >= s->tick + NET_HISTORY - NET_SNAPSHOTS) break;
+
+            InputCmd cmd = { (signed char)packet[NET_HEADER_SIZE + 2*k], packet[NET_HEADER_SIZE + 2*k + 1] };
+            InputCmd *used = &s->inputs[t & (NET_HISTORY - 1)][s->remote];
+
+            // Un tick ya simulado con otra entrada: hay que rehacerlo
+            if (t < s->tick && (used->move != cmd.move || used->buttons != cmd.buttons) && t < s->rollbackFrom)
+                s->rollbackFrom = t;
+
+            *used = cmd;
+            s->lastRemote = cmd;
+            s->remoteConfirmed++;
+        }
+    }
+}
+
+// Simula el tick s->tick con las entradas guardadas, tras guardar el estado previo
+static void SimulateNetTick(NetSession *s) {
+    InputCmd *cmds = s->inputs[s->tick & (NET_HISTORY - 1)];
+    if (s->tick >= s->remoteConfirmed) cmds[s->remote] = PredictRemote(s);
+
+    SaveSnapshot(&s->snapshots[s->tick % NET_SNAPSHOTS]);
+    GameTick(cmds);
+    s->hashes[s->tick & (NET_HISTORY - 1)] = HashGameState();
+    s->tick++;
+}
+
+// Vuelve al primer tick mal predicho y resimula hasta el actual
+static void RollbackNetSession(NetSession *s) {
+    if (s->rollbackFrom >= s->tick) {
+        s->rollbackFrom = INT_MAX;
+        return;
+    }
+
+    long long t0 = NowNs();
+    int target = s->tick;
+    int ticks = target - s->rollbackFrom;
+
+    RestoreSnapshot(&s->snapshots[s->rollbackFrom % NET_SNAPSHOTS]);
+    s->tick = s->rollbackFrom;
+    while (s->tick < target) SimulateNetTick(s);
+
+    long long spent = NowNs() - t0;
+    s->stats.rollbacks++;
+    s->stats.resimulated += ticks;
+    if (ticks > s->stats.maxRollback) s->stats.maxRollback = ticks;
+    if (spent > s->stats.maxRollbackNs) s->stats.maxRollbackNs = spent;
+
+    s->rollbackFrom = INT_MAX;
+}
+
+// ------------------------------
+// Recibir, corregir lo mal predicho y enviar lo retenido (sin avanzar).
+// Hay que llamarla aunque no toque simular (p. ej. al terminar) para que
+// el otro reciba las confirmaciones.
+// ------------------------------
+void UpdateNetSession(NetSession *s) {
+    if (!s->active) return;
+    ReceiveNetInputs(s);
+    RollbackNetSession(s);
+    SendNetInputs(s);
+    FlushNetShim(s);
+}
+
+// ------------------------------
+// Avanza un tick con la entrada local. Devuelve false si no se pudo porque
+// la entrada del otro lleva demasiado retraso (más de NET_MAX_ROLLBACK
+// ticks): la entrada local no se consume y hay que repetir la llamada.
+// ------------------------------
+bool NetTick(NetSession *s, InputCmd localCmd) {
+    ReceiveNetInputs(s);
+    RollbackNetSession(s);
+
+    if (s->tick - s->remoteConfirmed >= NET_MAX_ROLLBACK) {
+        s->stats.stalls++;
+        SendNetInputs(s);
+        FlushNetShim(s);
+        return false;
+    }
+
+    s->inputs[s->tick & (NET_HISTORY - 1)][s->local] = localCmd;
+    SimulateNetTick(s);
+
+    SendNetInputs(s);
+    FlushNetShim(s);
+    return true;
+}
+
+void CloseNetSession(NetSession *s) {
+    if (s->sock != NET_INVALID_SOCKET) {
+#if defined(_WIN32)
+        closesocket(s->sock);
+        WSACleanup();
+#else
+        close(s->sock);
+#endif
+    }
+    for (int i = 0; i < NET_SNAPSHOTS; i++) FreeSnapshot(&s->snapshots[i]);
+    *s = (NetSession){ 0 };
+    s->sock = NET_INVALID_SOCKET;
+}
+
+// ------------------------------
+// Ceder la CPU un momento mientras se espera al otro (ejecuciones sin ventana)
+// ------------------------------
+void NetIdle(void) {
+#if defined(_WIN32)
+    Sleep(1);
+#else
+    struct timespec ts = { 0, 250000 };
+    nanosleep(&ts, NULL);
+#endif
+}
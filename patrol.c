@@ -0,0 +1,115 @@
+// patrol.c
+// Tramos caminables para la patrulla de enemigos
+// -----------------------------------
+// Las plataformas no se mueven, así que al cargar el nivel se calcula para
+// cada enemigo el intervalo [minX, maxX] que puede recorrer: la superficie
+// en la que aparece, unida con las plataformas contiguas a la misma altura.
+// En cada tick la patrulla solo compara su X con ese intervalo.
+//
+// Se incluye después de arena.c.
+
+#include "raylib.h"
+#include <stdlib.h>
+#include <math.h>
+
+#define PATROL_SNAP_ABOVE  8.0f     // El enemigo puede estar hasta 8 por encima de la superficie
+#define PATROL_SNAP_BELOW  48.0f    // ... o hasta 48 por debajo (se ajusta a ella)
+
+typedef struct WalkSpan {
+    float minX, maxX;       // Recorrido del centro del enemigo
+    float y;                // Altura de la superficie (pies del enemigo)
+} WalkSpan;
+
+// Superficie caminable: parte superior de una o varias plataformas unidas
+typedef struct WalkSegment {
+    float y, x0, x1;
+} WalkSegment;
+
+static int CompareWalkSegment(const void *a, const void *b) {
+    const WalkSegment *sa = a, *sb = b;
+    if (sa->y != sb->y) return (sa->y < sb->y) ? -1 : 1;
+    if (sa->x0 != sb->x0) return (sa->x0 < sb->x0) ? -1 : 1;
+    return 0;
+}
+
+// Dentro de [first, end) (misma altura, ordenado por x0), el tramo que contiene x o -1
+static int FindSegmentAt(const WalkSegment *seg, int first, int end, float x) {
+    int lo = first, hi = end;           // primer x0 > x
+    while (lo < hi) {
+        int mid = (lo + hi)/2;
+        if (seg[mid].x0 <= x) lo = mid + 1; else hi = mid;
+    }
+    return (lo > first && x <= seg[lo - 1].x1) ? lo - 1 : -1;
+}
+
+// ----------------------------------------------------------------------
+// Calcula un WalkSpan por posición inicial. halfWidth[s] es medio ancho
+// del enemigo s: el centro se gira antes de que la caja salga de la
+// superficie.
+// Un enemigo que no aparece sobre ninguna plataforma queda con un tramo
+// vacío en su X (se da la vuelta en el sitio).
+// Coste: O(P log P) para unir las plataformas y O(log P) por enemigo y
+// altura dentro de la tolerancia.
+// Las superficies unidas son temporales: salen de scratch y se sueltan al
+// acabar (vuelve a su marca).
+// ----------------------------------------------------------------------
+void BuildWalkSpans(const Rectangle *platformBox, int platformCount,
+                    const Vector2 *spawn, int spawnCount, const float *halfWidth,
+                    Arena *scratch, WalkSpan *out) {
+
+    size_t mark = ArenaMark(scratch);
+    WalkSegment *seg = ArenaAlloc(scratch, (platformCount > 0 ? platformCount : 1)*sizeof(WalkSegment));
+
+    for (int i = 0; i < platformCount; i++)
+        seg[i] = (WalkSegment){ platformBox[i].y, platformBox[i].x, platformBox[i].x + platformBox[i].width };
+
+    qsort(seg, platformCount, sizeof(WalkSegment), CompareWalkSegment);
+
+    // Unir plataformas a la misma altura que se tocan o solapan
+    int segCount = 0;
+    for (int i = 0; i < platformCount; i++) {
+        WalkSegment *last = (segCount > 0) ? &seg[segCount - 1] : NULL;
+        if (last != NULL && last->y == seg[i].y && seg[i].x0 <= last->x1)
+            last->x1 = fmaxf(last->x1, seg[i].x1);
+        else
+            seg[segCount++] = seg[i];
+    }
+
+    for (int s = 0; s < spawnCount; s++) {
+        Vector2 p = spawn[s];
+        int best = -1;
+
+        // Primer tramo a altura >= p.y - PATROL_SNAP_BELOW
+        int lo = 0, hi = segCount;
+        while (lo < hi) {
+            int mid = (lo + hi)/2;
+            if (seg[mid].y < p.y - PATROL_SNAP_BELOW) lo = mid + 1; else hi = mid;
+        }
+
+        // Recorrer cada altura dentro de la tolerancia y quedarse con la más cercana
+        for (int first = lo; first < segCount && seg[first].y <= p.y + PATROL_SNAP_ABOVE; ) {
+            // Fin de esta altura (búsqueda binaria: una altura puede tener miles de tramos)
+            int end = first + 1, hiEnd = segCount;
+            while (end < hiEnd) {
+                int mid = (end + hiEnd)/2;
+                if (seg[mid].y == seg[first].y) end = mid + 1; else hiEnd = mid;
+            }
+
+            int k = FindSegmentAt(seg, first, end, p.x);
+            if (k >= 0 && (best < 0 || fabsf(p.y - seg[k].y) < fabsf(p.y - seg[best].y))) best = k;
+
+            first = end;
+        }
+
+        if (best >= 0) {
+            out[s] = (WalkSpan){ seg[best].x0 + halfWidth[s], seg[best].x1 - halfWidth[s], seg[best].y };
+
+            // Superficie más estrecha que el enemigo: se queda en el centro
+            if (out[s].minX > out[s].maxX) out[s].minX = out[s].maxX = (seg[best].x0 + seg[best].x1)/2;
+        }
+        else
+            out[s] = (WalkSpan){ p.x, p.x, p.y };
+    }
+
+    ArenaRewind(scratch, mark);
+}
@@ -1075,6 +1075,8 @@ RLAPI void SetTargetFPS(int fps);                                 // Set target
 RLAPI float GetFrameTime(void);                                   // Get time in seconds for last frame drawn (delta time)
 RLAPI double GetTime(void);                                       // Get elapsed time in seconds since InitWindow()
 RLAPI int GetFPS(void);                                           // Get current FPS
+RLAPI void SetLateInputLatch(bool enabled);                       // Set late input latch mode (poll input just before the next frame, requires VSYNC)
+RLAPI float GetInputLatency(void);                                // Get time in seconds from input polling to the end of the last buffers swap
 
 // Custom frame control functions
 // NOTE: Those functions are intended for advanced users that want full control over the frame processing
@@ -253,6 +253,10 @@ __declspec(dllimport) unsigned int __stdcall timeEndPeriod(unsigned int uPeriod)
     #define MAX_AUTOMATION_EVENTS      16384        // Maximum number of automation events to record
 #endif
 
+#ifndef LATE_INPUT_LATCH_MARGIN
+    #define LATE_INPUT_LATCH_MARGIN     0.002       // Time left before the expected swap in late input latch mode (seconds)
+#endif
+
 #ifndef DIRECTORY_FILTER_TAG
     #define DIRECTORY_FILTER_TAG       "DIR"        // Name tag used to request directory inclusion on directory scan
 #endif                                              // NOTE: Used in ScanDirectoryFiles(), ScanDirectoryFilesRecursively() and LoadDirectoryFilesEx()
@@ -362,6 +366,12 @@ typedef struct CoreData {
         unsigned long long int base;        // Base time measure for hi-res timer (PLATFORM_ANDROID, PLATFORM_DRM)
         unsigned int frameCounter;          // Frame counter
 
+        bool lateLatch;                     // Late input latch mode enabled (see SetLateInputLatch())
+        double latchPeriod;                 // Vertical refresh period for late input latch, 0 if not applied
+        double latchWork;                   // Expected update + draw time after input polling (late input latch)
+        double polled;                      // Time of the last input polling
+        double inputLatency;                // Measured time from input polling to end of buffers swap
+
     } Time;
 } CoreData;
 
@@ -934,6 +944,7 @@ void EndDrawing(void)
 #endif
 
 #if !defined(SUPPORT_CUSTOM_FRAME_CONTROL)
+    double swapStart = GetTime();
     SwapScreenBuffer();                  // Copy back buffer to front buffer (screen)
 
     // Frame time control system
@@ -943,10 +954,29 @@ void EndDrawing(void)
 
     CORE.Time.frame = CORE.Time.update + CORE.Time.draw;
 
+    // Input latency: from the input polling used by this frame to the end of the swap
+    if (CORE.Time.polled > 0.0) CORE.Time.inputLatency = CORE.Time.current - CORE.Time.polled;
+
+    double remaining = CORE.Time.target - CORE.Time.frame;
+
+    // Late input latch: with VSYNC the swap blocks until the vertical blank, so the
+    // input polled right after it waits a full refresh before reaching the screen.
+    // Instead, wait here and poll input only the expected update + draw time
+    // (plus a margin) before the next swap
+    if (CORE.Time.lateLatch && (CORE.Time.latchPeriod > 0.0) && (CORE.Time.polled > 0.0))
+    {
+        double work = swapStart - CORE.Time.polled;
+        if (work > CORE.Time.latchWork) CORE.Time.latchWork = work;         // Grow at once: a late swap misses the blank
+        else CORE.Time.latchWork += (work - CORE.Time.latchWork)*0.05;     // Shrink slowly
+
+        double period = (CORE.Time.target > CORE.Time.latchPeriod)? CORE.Time.target : CORE.Time.latchPeriod;
+        remaining = period - CORE.Time.latchWork - LATE_INPUT_LATCH_MARGIN;
+    }
+
     // Wait for some milliseconds...
-    if (CORE.Time.frame < CORE.Time.target)
+    if (remaining > 0.0)
     {
-        WaitTime(CORE.Time.target - CORE.Time.frame);
+        WaitTime(remaining);
 
         CORE.Time.current = GetTime();
         double waitTime = CORE.Time.current - CORE.Time.previous;
@@ -956,6 +986,7 @@ void EndDrawing(void)
     }
 
     PollInputEvents();      // Poll user events (before next frame update)
+    CORE.Time.polled = GetTime();
 #endif
 
 #if defined(SUPPORT_SCREEN_CAPTURE)
@@ -1699,6 +1730,31 @@ float GetFrameTime(void)
     return (float)CORE.Time.frame;
 }
 
+// Set late input latch mode: input is polled as late as possible before the next frame
+// NOTE: Only effective with FLAG_VSYNC_HINT, without it EndDrawing() already polls input
+// right before the next frame update; call it after InitWindow()
+void SetLateInputLatch(bool enabled)
+{
+    CORE.Time.lateLatch = enabled;
+    CORE.Time.latchPeriod = 0.0;
+    CORE.Time.latchWork = 0.0;
+
+    if (enabled && FLAG_CHECK(CORE.Window.flags, FLAG_VSYNC_HINT))
+    {
+        int refreshRate = GetMonitorRefreshRate(GetCurrentMonitor());
+        if (refreshRate > 0) CORE.Time.latchPeriod = 1.0/(double)refreshRate;
+    }
+
+    if (enabled && (CORE.Time.latchPeriod > 0.0)) TRACELOG(LOG_INFO, "TIMER: Late input latch enabled (refresh period: %02.03f milliseconds)", (float)CORE.Time.latchPeriod*1000.0f);
+    else if (enabled) TRACELOG(LOG_INFO, "TIMER: Late input latch requires VSYNC, input polling not changed");
+}
+
+// Get time in seconds from input polling to the end of the last buffers swap (input latency)
+float GetInputLatency(void)
+{
+    return (float)CORE.Time.inputLatency;
+}
+
 //----------------------------------------------------------------------------------
 // Module Functions Definition: Custom frame control
 //----------------------------------------------------------------------------------
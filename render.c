@@ -0,0 +1,237 @@
+// render.c
+// Dibujo del mundo de juego: plataformas, enemigos, objetos, disparos y jugador
+// -----------------------------------
+// Solo lee el estado de gameplay.c (nunca lo modifica). Se dibuja entre
+// BeginMode2D/EndMode2D con la cámara ya colocada. Lo usan el juego
+// (main.c) y las pruebas de rendimiento (bench.c, con el dibujo simulado).
+
+#include "raylib.h"
+
+// ------------------------------
+// Sprites de plataformas (se cargan solo mientras algún trozo cargado
+// usa su tipo, ver SyncPlatformTextures) y suelo. Con el atlas son zonas
+// de la misma página y cargarlos no cuesta nada.
+// ------------------------------
+static const char *platformTexPath[PLATFORM_TYPES] = {
+    "resources/Sprites/Plataformas/suelo.png", "resources/Sprites/Plataformas/suelo.png",
+    "resources/Sprites/Plataformas/suelo.png", "resources/Sprites/Plataformas/suelo.png",
+    "resources/Sprites/Plataformas/suelo.png", "resources/Sprites/Plataformas/suelo.png",
+    "resources/Sprites/Plataformas/suelo.png", "resources/Sprites/Plataformas/suelo.png",
+    "resources/Sprites/Plataformas/suelo.png", "resources/Sprites/Plataformas/suelo.png",
+    "resources/Sprites/Plataformas/suelo.png"
+};
+static Sprite platformTex[PLATFORM_TYPES];
+static Sprite groundTex;
+
+// ------------------------------
+// Marcadores de puntos ("+100") que suben y se desvanecen donde se ganaron.
+// Salen de la cola de eventos (events.c) con su propio lector, una vez por
+// frame. En red un rollback puede repetir alguno (se vuelven a generar).
+// ------------------------------
+#define SCORE_POPUPS 32
+#define SCORE_POPUP_TIME 0.8f       // Segundos en pantalla
+#define SCORE_POPUP_RISE 40.0f      // Píxeles que sube en ese tiempo
+
+typedef struct ScorePopup {
+    Vector2 pos;
+    int points;
+    float time;                     // Tiempo restante (0 = libre)
+} ScorePopup;
+
+static ScorePopup scorePopups[SCORE_POPUPS];
+static int scorePopupNext = 0;
+static GameEventReader popupEvents = { 0 };
+
+
+// ------------------------------
+// Cargar / descargar
+// ------------------------------
+void LoadWorldTextures() {
+    //Fondo nivel
+    groundTex = LoadSprite("resources/Sprites/Plataformas/cielo.png");
+}
+
+void UnloadWorldTextures() {
+    for (int i = 0; i < PLATFORM_TYPES; i++) {
+        if (platformTex[i].texture.id != 0) UnloadSprite(platformTex[i]);
+        platformTex[i] = (Sprite){ 0 };
+    }
+
+    UnloadSprite(groundTex);
+}
+
+
+// ------------------------------
+// Texturas de plataforma según los trozos cargados:
+// se cargan al aparecer su tipo y se liberan al desalojarse el último.
+// Las que usan las casillas se quedan mientras dure el nivel.
+// ------------------------------
+void SyncPlatformTextures() {
+    for (int i = 0; i < PLATFORM_TYPES; i++) {
+        bool used = stream.typeRefs[i] > 0 || tileTypeUsed[i];
+
+        if (used && platformTex[i].texture.id == 0) platformTex[i] = LoadSprite(platformTexPath[i]);
+        else if (!used && platformTex[i].texture.id != 0) {
+            UnloadSprite(platformTex[i]);
+            platformTex[i] = (Sprite){ 0 };
+        }
+    }
+}
+
+
+// ------------------------------
+// Leer los eventos nuevos y envejecer los marcadores (dt: tiempo del frame)
+// ------------------------------
+static void AddScorePopup(Vector2 pos, int points) {
+    scorePopups[scorePopupNext] = (ScorePopup){ pos, points, SCORE_POPUP_TIME };
+    scorePopupNext = (scorePopupNext + 1) % SCORE_POPUPS;   // Si no caben, se pisa el más viejo
+}
+
+void UpdateScorePopups(float dt) {
+    for (int i = 0; i < SCORE_POPUPS; i++)
+        if (scorePopups[i].time > 0) scorePopups[i].time -= dt;
+
+    GameEvent e;
+    while (ReadGameEvent(&gameEvents, &popupEvents, &e)) {
+        if (e.type == EVENT_ENEMY_KILLED)
+            AddScorePopup(e.as.enemyKilled.pos, enemyTypes[enemies.type[e.as.enemyKilled.enemy]].score);
+        else if (e.type == EVENT_COLLECTIBLE_TAKEN) AddScorePopup(e.as.collectibleTaken.pos, 50);
+    }
+}
+
+
+// ------------------------------
+// Interpolar entre dos ticks al dibujar
+// ------------------------------
+Vector2 InterpolatePos(Vector2 prev, Vector2 cur, float alpha) {
+    return (Vector2){
+        prev.x + (cur.x - prev.x)*alpha,
+        prev.y + (cur.y - prev.y)*alpha
+    };
+}
+
+
+// ------------------------------
+// Casillas dentro de la vista. Cada tramo seguido del mismo tipo en una
+// fila es un solo rectángulo (una llamada de dibujo, no una por casilla).
+// ------------------------------
+static void DrawTiles(Rectangle view) {
+    if (tileMap.cols == 0) return;
+
+    float ts = tileMap.tileSize;
+    int x0 = TileColumnOf(&tileMap, view.x), x1 = TileColumnOf(&tileMap, view.x + view.width);
+    int y0 = TileRowOf(&tileMap, view.y), y1 = TileRowOf(&tileMap, view.y + view.height);
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 >= tileMap.cols) x1 = tileMap.cols - 1;
+    if (y1 >= tileMap.rows) y1 = tileMap.rows - 1;
+
+    for (int y = y0; y <= y1; y++) {
+        if (!TileRowAnySolid(&tileMap, y, x0, x1)) continue;
+
+        for (int x = x0; x <= x1; ) {
+            int type = GetTileType(&tileMap, x, y);
+            int end = x + 1;
+            while (end <= x1 && GetTileType(&tileMap, end, y) == type) end++;
+
+            if (type != 0) {
+                Rectangle r = { tileMap.origin.x + x*ts, tileMap.origin.y + y*ts, (end - x)*ts, ts };
+                if (type - 1 == PLATFORM_GROUND) DrawRectangleRec(r, BROWN);
+                else DrawSpritePro(platformTex[PlatformTexType(type - 1)], r, WHITE);
+            }
+            x = end;
+        }
+    }
+}
+
+
+// ------------------------------
+// Dibujar el mundo (alpha: fracción de tick para interpolar)
+// ------------------------------
+void DrawWorld(float alpha) {
+
+    // Plataformas: solo las cargadas que caen en la vista de la cámara
+    Rectangle view = {
+        camera.target.x - camera.offset.x/camera.zoom - 64,
+        camera.target.y - camera.offset.y/camera.zoom - 64,
+        SCREEN_WIDTH/camera.zoom + 128,
+        SCREEN_HEIGHT/camera.zoom + 128
+    };
+    int visibleCount;
+    const int *visible = SpatialHashQuery(&platformGrid, view, &visibleCount);
+
+    for (int k=0;k<visibleCount;k++) {
+
+        int i = visible[k];
+        Rectangle b = platforms.box[i];
+
+        if (platforms.type[i] == 11) {
+            DrawSpritePro(groundTex, (Rectangle){b.x, b.y - b.height, b.width, b.height}, WHITE);
+        }
+        else {
+            // El tipo viene del archivo del nivel: fuera de rango se usa el 0
+            DrawSpritePro(platformTex[PlatformTexType(platforms.type[i])],
+                          (Rectangle){b.x, b.y - b.height/3, b.width, b.height}, WHITE);
+        }
+    }
+    //Suelos
+    for (int k=0;k<visibleCount;k++)
+        if (platforms.type[visible[k]] == PLATFORM_GROUND) DrawRectangleRec(platforms.box[visible[k]], BROWN);
+
+    DrawTiles(view);
+
+
+    // ------------------------------
+    // DIBUJAR ENEMIGOS ANIMADOS
+    // ------------------------------
+    // Solo los despiertos: los dormidos están fuera de la vista. Arquetipo
+    // a arquetipo (la lista está agrupada), con los muertos que aún se ven
+    // de cada uno detrás: las hojas de un arquetipo van seguidas.
+    int typeStart = 0;
+    for (int t = 0; t < ENEMY_TYPES; t++) {
+        for (int k = typeStart; k < enemies.awakeTypeEnd[t]; k++) {
+            int i = enemies.awake[k];
+            DrawEnemyAnimation(t, InterpolatePos(enemies.prevPos[i], enemies.pos[i], alpha), enemies.dir[i],
+                               enemies.animClip[i], enemies.animFrame[i]);
+        }
+        typeStart = enemies.awakeTypeEnd[t];
+
+        for (int k = 0; k < enemies.dyingCount; k++) {
+            int i = enemies.dying[k];
+            if (enemies.type[i] == t)
+                DrawEnemyAnimation(t, enemies.pos[i], enemies.dir[i], enemies.animClip[i], enemies.animFrame[i]);
+        }
+    }
+
+    // Coleccionables
+    for (int k=0;k<collectibles.aliveCount;k++)
+        DrawCircleV(collectibles.pos[collectibles.alive[k]], 8, GOLD);
+
+    // Proyectiles
+    for (int k=0;k<shoot.aliveCount;k++) {
+        int i = shoot.alive[k];
+
+        Rectangle r = shoot.rec[i];
+        Vector2 p = InterpolatePos(shoot.prevPos[i], (Vector2){ r.x, r.y }, alpha);
+        DrawRectangleRec((Rectangle){ p.x, p.y, r.width, r.height }, MAROON);
+    }
+
+    // Jugadores (el local encima)
+    for (int p = 0; p < playerCount; p++) {
+        if (p == localPlayer) continue;
+        DrawPlayer(&players[p].anim, InterpolatePos(players[p].prevPos, players[p].pos, alpha));
+    }
+    DrawPlayer(&players[localPlayer].anim, InterpolatePos(players[localPlayer].prevPos, players[localPlayer].pos, alpha));
+
+    // Marcadores de puntos
+    for (int i = 0; i < SCORE_POPUPS; i++) {
+        const ScorePopup *sp = &scorePopups[i];
+        if (sp->time <= 0) continue;
+        float t = sp->time / SCORE_POPUP_TIME;
+        DrawText(TextFormat("+%d", sp->points), (int)sp->pos.x - 12,
+                 (int)(sp->pos.y - 48 - (1 - t)*SCORE_POPUP_RISE), 16, Fade(GOLD, t));
+    }
+
+    DrawRectangle((int)levelGoalX, 0, 8, 800, GREEN);
+    DrawText("META", (int)levelGoalX - 10, -20, 20, BLACK);
+}
@@ -0,0 +1,201 @@
+// replay.c
+// Grabación y reproducción de partidas como flujo de comandos por tick
+// -----------------------------------
+// La simulación solo depende de ResetLevel y de un InputCmd por tick, así
+// que guardar esos comandos basta para repetir una partida bit a bit.
+//
+// Formato del archivo (little endian):
+//   cabecera: "PRPL", versión (u16), SIM_HZ (u16), ticks (u32)
+//   tramos:   repeticiones (u16), move (i8), buttons (u8)
+//   huellas:  "HASH", algoritmo (u16), intervalo (u16), n (u32), n x u32
+// Los tramos agrupan ticks seguidos con el mismo comando (RLE), así una
+// partida típica ocupa pocos KB.
+//
+// Huellas (versión 2): cada REPLAY_HASH_INTERVAL ticks se guarda la huella
+// encadenada del estado (statehash.c). Al reproducir se compara y se sabe
+// en qué tramo se desvió la simulación. Los archivos de la versión 1 no
+// tienen huellas y se reproducen sin comprobar. Se incluye después de
+// statehash.c.
+
+#include "raylib.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define REPLAY_VERSION 2
+#define REPLAY_HASH_INTERVAL 60     // Ticks por huella guardada (medio segundo)
+
+typedef struct Replay {
+    InputCmd *cmds;     // Un comando por tick
+    int count;
+    int capacity;
+    int cursor;         // Siguiente tick a reproducir
+
+    uint32_t *hashes;   // Huella encadenada al final de cada intervalo
+    int hashCount;
+    int hashCapacity;
+    int hashAlgo;       // STATE_HASH_ALGO con el que se grabaron
+    uint32_t chain;     // Huella encadenada hasta el último tick
+} Replay;
+
+// ----------------------------------------------------------------------
+// Lectura/escritura little endian
+// ----------------------------------------------------------------------
+static void PutU16(unsigned char *p, unsigned int v) { p[0] = v & 0xff; p[1] = (v >> 8) & 0xff; }
+static void PutU32(unsigned char *p, unsigned int v) { PutU16(p, v & 0xffff); PutU16(p + 2, v >> 16); }
+static unsigned int GetU16(const unsigned char *p) { return p[0] | (p[1] << 8); }
+static unsigned int GetU32(const unsigned char *p) { return GetU16(p) | (GetU16(p + 2) << 16); }
+
+// ----------------------------------------------------------------------
+// Memoria
+// ----------------------------------------------------------------------
+void ClearReplay(Replay *r) {
+    r->count = 0;
+    r->cursor = 0;
+    r->hashCount = 0;
+    r->hashAlgo = STATE_HASH_ALGO;
+    r->chain = 0;
+}
+
+void FreeReplay(Replay *r) {
+    free(r->cmds);
+    free(r->hashes);
+    *r = (Replay){ 0 };
+}
+
+static void AppendReplayHash(Replay *r, uint32_t hash) {
+    if (r->hashCount == r->hashCapacity) {
+        r->hashCapacity = (r->hashCapacity > 0) ? r->hashCapacity*2 : 256;
+        r->hashes = GrowField(r->hashes, r->hashCapacity, sizeof(uint32_t));
+    }
+    r->hashes[r->hashCount++] = hash;
+}
+
+void AppendReplay(Replay *r, InputCmd cmd) {
+    if (r->count == r->capacity) {
+        r->capacity = (r->capacity > 0) ? r->capacity*2 : 4096;
+        r->cmds = GrowField(r->cmds, r->capacity, sizeof(InputCmd));
+    }
+    r->cmds[r->count++] = cmd;
+}
+
+// Siguiente comando grabado; false cuando se acaba la grabación
+bool NextReplayCmd(Replay *r, InputCmd *cmd) {
+    if (r->cursor >= r->count) return false;
+    *cmd = r->cmds[r->cursor++];
+    return true;
+}
+
+// ----------------------------------------------------------------------
+// Huellas. Se llaman después de simular el tick del último comando
+// añadido (grabando) o leído (reproduciendo).
+// ----------------------------------------------------------------------
+void RecordReplayHash(Replay *r, uint32_t tickHash) {
+    if (STATE_HASH_ALGO == 0) return;
+    r->hashAlgo = STATE_HASH_ALGO;
+    r->chain = ChainStateHash(r->chain, tickHash);
+    if (r->count % REPLAY_HASH_INTERVAL == 0) AppendReplayHash(r, r->chain);
+}
+
+// false si la huella del intervalo que acaba en este tick no coincide con
+// la grabada (sin huellas, o de otro algoritmo, siempre true)
+bool CheckReplayHash(Replay *r, uint32_t tickHash) {
+    if (STATE_HASH_ALGO == 0 || r->hashAlgo != STATE_HASH_ALGO) return true;
+    r->chain = ChainStateHash(r->chain, tickHash);
+
+    if (r->cursor % REPLAY_HASH_INTERVAL != 0) return true;
+    int k = r->cursor/REPLAY_HASH_INTERVAL - 1;
+    return (k >= r->hashCount) || (r->hashes[k] == r->chain);
+}
+
+// ----------------------------------------------------------------------
+// Guardar
+// ----------------------------------------------------------------------
+bool SaveReplay(const Replay *r, const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) return false;
+
+    unsigned char header[12];
+    memcpy(header, "PRPL", 4);
+    PutU16(header + 4, REPLAY_VERSION);
+    PutU16(header + 6, SIM_HZ);
+    PutU32(header + 8, (unsigned int)r->count);
+    fwrite(header, 1, sizeof(header), f);
+
+    for (int i = 0; i < r->count; ) {
+        InputCmd c = r->cmds[i];
+        int run = 1;
+        while (i + run < r->count && run < 0xffff &&
+               r->cmds[i + run].move == c.move && r->cmds[i + run].buttons == c.buttons) run++;
+
+        unsigned char span[4];
+        PutU16(span, (unsigned int)run);
+        span[2] = (unsigned char)c.move;
+        span[3] = c.buttons;
+        fwrite(span, 1, sizeof(span), f);
+
+        i += run;
+    }
+
+    unsigned char hashHeader[12];
+    memcpy(hashHeader, "HASH", 4);
+    PutU16(hashHeader + 4, (unsigned int)r->hashAlgo);
+    PutU16(hashHeader + 6, REPLAY_HASH_INTERVAL);
+    PutU32(hashHeader + 8, (unsigned int)r->hashCount);
+    fwrite(hashHeader, 1, sizeof(hashHeader), f);
+
+    for (int k = 0; k < r->hashCount; k++) {
+        unsigned char h[4];
+        PutU32(h, r->hashes[k]);
+        fwrite(h, 1, sizeof(h), f);
+    }
+
+    bool ok = (ferror(f) == 0);
+    fclose(f);
+    return ok;
+}
+
+// ----------------------------------------------------------------------
+// Cargar (rechaza archivos de otra versión o de otra frecuencia de tick;
+// la versión 1 se acepta sin huellas)
+// ----------------------------------------------------------------------
+bool LoadReplay(Replay *r, const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) return false;
+
+    unsigned char header[12];
+    if (fread(header, 1, sizeof(header), f) != sizeof(header) ||
+        memcmp(header, "PRPL", 4) != 0 ||
+        GetU16(header + 4) < 1 || GetU16(header + 4) > REPLAY_VERSION ||
+        GetU16(header + 6) != SIM_HZ) {
+        fclose(f);
+        return false;
+    }
+
+    int total = (int)GetU32(header + 8);
+    ClearReplay(r);
+    r->hashAlgo = 0;
+
+    unsigned char span[4];
+    while (r->count < total && fread(span, 1, sizeof(span), f) == sizeof(span)) {
+        InputCmd c = { (signed char)span[2], span[3] };
+        for (unsigned int k = GetU16(span); k > 0 && r->count < total; k--)
+            AppendReplay(r, c);
+    }
+
+    // Huellas (solo versión 2); si el intervalo no es el de esta versión no se usan
+    unsigned char hashHeader[12];
+    if (GetU16(header + 4) >= 2 && fread(hashHeader, 1, sizeof(hashHeader), f) == sizeof(hashHeader) &&
+        memcmp(hashHeader, "HASH", 4) == 0 && GetU16(hashHeader + 6) == REPLAY_HASH_INTERVAL) {
+
+        unsigned int n = GetU32(hashHeader + 8);
+        unsigned char h[4];
+        for (unsigned int k = 0; k < n && fread(h, 1, sizeof(h), f) == sizeof(h); k++)
+            AppendReplayHash(r, GetU32(h));
+        r->hashAlgo = (int)GetU16(hashHeader + 4);
+    }
+
+    fclose(f);
+    return (r->count == total);
+}
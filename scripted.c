@@ -0,0 +1,27 @@
+// scripted.c
+// Utilidades comunes de las ejecuciones sin ventana (headless.c, bench.c)
+// -----------------------------------
+// Se incluye después de gameplay.c: la entrada guionizada mira el estado
+// de la partida para reiniciarla al terminar.
+
+// ------------------------------
+// Entrada guionizada: correr a la derecha, saltar y disparar a ritmo fijo
+// ------------------------------
+static InputCmd ScriptedInput(long long tick) {
+    InputCmd cmd = { 0 };
+    cmd.move = ((tick/600) % 5 == 4) ? -127 : 127;     // retrocede de vez en cuando
+    if (tick % 45 == 0) cmd.buttons |= INPUT_JUMP;
+    if (tick % 20 == 0) cmd.buttons |= INPUT_SHOOT;
+
+    // Fin de partida: se reinicia para seguir midiendo (soak test)
+    if (gameOver || victory) cmd.buttons |= INPUT_RESET;
+    return cmd;
+}
+
+// ------------------------------
+// Entrada de cada jugador en cooperativo: el mismo guion, desfasado para
+// que no salten ni disparen a la vez
+// ------------------------------
+static InputCmd ScriptedInputPlayer(int player, long long tick) {
+    return ScriptedInput(tick + player*137);
+}
@@ -0,0 +1,310 @@
+// snapshot.c
+// Instantáneas del estado de la partida (puntos de control, reintento
+// rápido y base para rebobinar o hacer rollback)
+// -----------------------------------
+// SaveSnapshot copia todo el estado que cambia durante la partida a un
+// búfer plano reservado de antemano; RestoreSnapshot lo devuelve tal cual.
+// Son copias de arrays contiguos (memcpy) sin reservas por entidad, así que
+// se pueden llamar en cada tick.
+//
+// Contenido del búfer:
+//   SnapshotHeader         jugadores, banderas, cámara, contadores, sumas
+//                          de la huella
+//   arrays de enemigos     por campo (animación incluida) de cada rango de
+//                          arquetipo, solo sus huecos usados (ver
+//                          EnemySnapshotRanges); alive[aliveCount],
+//                          awake[awakeCount], dying[dyingCount]
+//   arrays de objetos      [count] por campo, alive[aliveCount]
+//   arrays de disparos     [count] por campo, alive[aliveCount], freeList[freeCount]
+//   estado de cada posición inicial del nivel (enemigos y objetos)
+//
+// Lo que no se copia se reconstruye al restaurar: las rejillas de
+// enemigos y objetos (a partir de los vivos) y las plataformas cargadas
+// (a partir del rango de trozos). La geometría del nivel no cambia; una
+// instantánea solo vale para el nivel cargado cuando se tomó.
+
+#include <string.h>
+
+typedef struct SnapshotHeader {
+    const void *level;              // Nivel en el que se tomó (level.header)
+    Player players[MAX_PLAYERS];
+    int playerCount;
+    Camera2D camera;
+    int shootRate;
+    bool gameOver, victory, pauseGame;
+    int activationCell, activationCellMax;
+    int streamFirst, streamLast;
+
+    int enemyCount, enemyAlive, enemyAwake, enemyDying;
+    int enemyTypeCount[ENEMY_TYPES], enemyAwakeTypeEnd[ENEMY_TYPES];
+    int collectibleCount, collectibleAlive;
+    int shootCount, shootAlive, shootFree;
+    StateMix mix;                   // Sumas de la huella (statemix.c)
+} SnapshotHeader;
+
+typedef struct GameSnapshot {
+    unsigned char *data;
+    size_t size;                    // Bytes en uso
+    size_t capacity;                // Bytes reservados
+} GameSnapshot;
+
+// Bytes por elemento de cada almacén (todos sus arrays)
+#define SNAPSHOT_ENEMY_BYTES (3*sizeof(Vector2) + sizeof(Rectangle) + 2*sizeof(int) + 3*sizeof(float) + sizeof(bool) + \
+                              4*sizeof(int) + sizeof(unsigned char))
+#define SNAPSHOT_COLLECTIBLE_BYTES (sizeof(Vector2) + sizeof(Rectangle) + sizeof(bool) + 2*sizeof(int))
+#define SNAPSHOT_SHOOT_BYTES (sizeof(Rectangle) + 2*sizeof(Vector2) + sizeof(float) + sizeof(bool) + 3*sizeof(int))
+#define SNAPSHOT_MIN_SHOOTS 64
+
+// Huecos de enemigos que se copian: con rangos por arquetipo, los usados de
+// cada uno (typeCount), no los libres que quedan detrás de cada rango (con
+// ellos la copia crecería con el tamaño del nivel); sin rangos, los count
+// primeros. Devuelve cuántos tramos hay en first/count.
+static int EnemySnapshotRanges(int first[ENEMY_TYPES], int count[ENEMY_TYPES]) {
+    if (!enemies.grouped) {
+        first[0] = 0;
+        count[0] = enemies.count;
+        return 1;
+    }
+    for (int t = 0; t < ENEMY_TYPES; t++) {
+        first[t] = enemies.typeFirst[t];
+        count[t] = enemies.typeCount[t];
+    }
+    return ENEMY_TYPES;
+}
+
+static size_t EnemySnapshotSlots(void) {
+    int first[ENEMY_TYPES], count[ENEMY_TYPES];
+    int ranges = EnemySnapshotRanges(first, count);
+    size_t slots = 0;
+    for (int r = 0; r < ranges; r++) slots += count[r];
+    return slots;
+}
+
+// Tamaño que ocuparía el estado actual
+static size_t SnapshotSize(void) {
+    const LevelHeader *h = level.header;
+    return sizeof(SnapshotHeader) +
+           EnemySnapshotSlots()*SNAPSHOT_ENEMY_BYTES +
+           (size_t)collectibles.count*SNAPSHOT_COLLECTIBLE_BYTES +
+           (size_t)shoot.count*SNAPSHOT_SHOOT_BYTES +
+           h->enemyCount + h->collectibleCount;
+}
+
+// Reserva para el nivel cargado: cada almacén tiene como mucho un hueco
+// por posición inicial; los disparos, los que caben ahora o un mínimo.
+// Si alguna vez no basta, SaveSnapshot crece (no en cada tick).
+void InitSnapshot(GameSnapshot *s) {
+    const LevelHeader *h = level.header;
+    int shoots = (shoot.capacity > SNAPSHOT_MIN_SHOOTS) ? shoot.capacity : SNAPSHOT_MIN_SHOOTS;
+
+    size_t bytes = sizeof(SnapshotHeader) +
+                   h->enemyCount*SNAPSHOT_ENEMY_BYTES +
+                   h->collectibleCount*SNAPSHOT_COLLECTIBLE_BYTES +
+                   (size_t)shoots*SNAPSHOT_SHOOT_BYTES +
+                   h->enemyCount + h->collectibleCount;
+
+    if (bytes > s->capacity) {
+        free(s->data);
+        s->data = GrowField(NULL, 1, bytes);
+        s->capacity = bytes;
+    }
+    s->size = 0;
+}
+
+void FreeSnapshot(GameSnapshot *s) {
+    free(s->data);
+    *s = (GameSnapshot){ 0 };
+}
+
+static unsigned char *PutBytes(unsigned char *p, const void *src, size_t n) {
+    memcpy(p, src, n);
+    return p + n;
+}
+
+static const unsigned char *GetBytes(const unsigned char *p, void *dst, size_t n) {
+    memcpy(dst, p, n);
+    return p + n;
+}
+
+// ------------------------------
+// Guardar
+// ------------------------------
+void SaveSnapshot(GameSnapshot *s) {
+    size_t size = SnapshotSize();
+    if (size > s->capacity) {
+        s->data = GrowField(s->data, 1, size + size/2);
+        s->capacity = size + size/2;
+    }
+
+    SnapshotHeader hdr = {
+        .level = level.header,
+        .playerCount = playerCount, .camera = camera, .shootRate = shootRate,
+        .gameOver = gameOver, .victory = victory, .pauseGame = pauseGame,
+        .activationCell = activationCell, .activationCellMax = activationCellMax,
+        .streamFirst = stream.first, .streamLast = stream.last,
+        .enemyCount = enemies.count, .enemyAlive = enemies.aliveCount, .enemyAwake = enemies.awakeCount,
+        .enemyDying = enemies.dyingCount,
+        .collectibleCount = collectibles.count, .collectibleAlive = collectibles.aliveCount,
+        .shootCount = shoot.count, .shootAlive = shoot.aliveCount, .shootFree = shoot.freeCount,
+        .mix = stateMix
+    };
+    memcpy(hdr.players, players, sizeof(players));
+    memcpy(hdr.enemyTypeCount, enemies.typeCount, sizeof(hdr.enemyTypeCount));
+    memcpy(hdr.enemyAwakeTypeEnd, enemies.awakeTypeEnd, sizeof(hdr.enemyAwakeTypeEnd));
+
+    unsigned char *p = PutBytes(s->data, &hdr, sizeof(hdr));
+
+    int first[ENEMY_TYPES], count[ENEMY_TYPES];
+    int ranges = EnemySnapshotRanges(first, count);
+    for (int r = 0; r < ranges; r++) {
+        int f = first[r], n = count[r];
+        p = PutBytes(p, enemies.pos + f, n*sizeof(Vector2));
+        p = PutBytes(p, enemies.prevPos + f, n*sizeof(Vector2));
+        p = PutBytes(p, enemies.vel + f, n*sizeof(Vector2));
+        p = PutBytes(p, enemies.box + f, n*sizeof(Rectangle));
+        p = PutBytes(p, enemies.dir + f, n*sizeof(int));
+        p = PutBytes(p, enemies.spanMin + f, n*sizeof(float));
+        p = PutBytes(p, enemies.spanMax + f, n*sizeof(float));
+        p = PutBytes(p, enemies.active + f, n*sizeof(bool));
+        p = PutBytes(p, enemies.spawn + f, n*sizeof(int));
+        p = PutBytes(p, enemies.animClip + f, n*sizeof(unsigned char));
+        p = PutBytes(p, enemies.animFrame + f, n*sizeof(int));
+        p = PutBytes(p, enemies.animTimer + f, n*sizeof(float));
+    }
+    p = PutBytes(p, enemies.alive, enemies.aliveCount*sizeof(int));
+    p = PutBytes(p, enemies.awake, enemies.awakeCount*sizeof(int));
+    p = PutBytes(p, enemies.dying, enemies.dyingCount*sizeof(int));
+
+    int n = collectibles.count;
+    p = PutBytes(p, collectibles.pos, n*sizeof(Vector2));
+    p = PutBytes(p, collectibles.box, n*sizeof(Rectangle));
+    p = PutBytes(p, collectibles.taken, n*sizeof(bool));
+    p = PutBytes(p, collectibles.spawn, n*sizeof(int));
+    p = PutBytes(p, collectibles.alive, collectibles.aliveCount*sizeof(int));
+
+    n = shoot.count;
+    p = PutBytes(p, shoot.rec, n*sizeof(Rectangle));
+    p = PutBytes(p, shoot.prevPos, n*sizeof(Vector2));
+    p = PutBytes(p, shoot.speed, n*sizeof(Vector2));
+    p = PutBytes(p, shoot.life, n*sizeof(float));
+    p = PutBytes(p, shoot.owner, n*sizeof(int));
+    p = PutBytes(p, shoot.active, n*sizeof(bool));
+    p = PutBytes(p, shoot.alive, shoot.aliveCount*sizeof(int));
+    p = PutBytes(p, shoot.freeList, shoot.freeCount*sizeof(int));
+
+    p = PutBytes(p, stream.enemyState, level.header->enemyCount);
+    p = PutBytes(p, stream.collectibleState, level.header->collectibleCount);
+
+    s->size = (size_t)(p - s->data);
+}
+
+// Cambia las plataformas cargadas al rango [first, last] sin tocar
+// enemigos ni objetos (esos vienen en la instantánea)
+static void RestorePlatformRange(int first, int last) {
+    if (first == stream.first && last == stream.last) return;
+
+    for (int c = stream.first; c <= stream.last; c++)
+        if (c < first || c > last) UnloadChunkPlatforms(c);
+    for (int c = first; c <= last; c++)
+        if (c < stream.first || c > stream.last) LoadChunkPlatforms(c);
+
+    stream.first = first;
+    stream.last = last;
+}
+
+// ------------------------------
+// Restaurar (false si la instantánea está vacía o es de otro nivel)
+// ------------------------------
+bool RestoreSnapshot(const GameSnapshot *s) {
+    if (s->size < sizeof(SnapshotHeader)) return false;
+
+    SnapshotHeader hdr;
+    const unsigned char *p = GetBytes(s->data, &hdr, sizeof(hdr));
+    if (hdr.level != level.header || hdr.playerCount != playerCount) return false;
+
+    // Fuera de las rejillas lo que hay ahora; se vuelve a meter lo restaurado
+    for (int k = 0; k < enemies.aliveCount; k++) SpatialHashRemove(&enemyGrid, enemies.alive[k]);
+    for (int k = 0; k < collectibles.aliveCount; k++) SpatialHashRemove(&collectibleGrid, collectibles.alive[k]);
+
+    RestorePlatformRange(hdr.streamFirst, hdr.streamLast);
+
+    memcpy(players, hdr.players, sizeof(players));
+    camera = hdr.camera;
+    shootRate = hdr.shootRate;
+    gameOver = hdr.gameOver;
+    victory = hdr.victory;
+    pauseGame = hdr.pauseGame;
+    activationCell = hdr.activationCell;
+    activationCellMax = hdr.activationCellMax;
+    stateMix = hdr.mix;
+
+    int n = hdr.enemyCount;
+    ReserveEnemies(&enemies, n);
+    enemies.count = n;
+    enemies.aliveCount = hdr.enemyAlive;
+    enemies.awakeCount = hdr.enemyAwake;
+    enemies.dyingCount = hdr.enemyDying;
+    memcpy(enemies.typeCount, hdr.enemyTypeCount, sizeof(enemies.typeCount));
+    memcpy(enemies.awakeTypeEnd, hdr.enemyAwakeTypeEnd, sizeof(enemies.awakeTypeEnd));
+
+    // Los huecos libres de cada rango se quedan como estén: ninguno está
+    // activo ni en las listas, y NewEnemy los rellena al usarlos
+    int first[ENEMY_TYPES], count[ENEMY_TYPES];
+    int ranges = EnemySnapshotRanges(first, count);
+    for (int r = 0; r < ranges; r++) {
+        int f = first[r];
+        n = count[r];
+        p = GetBytes(p, enemies.pos + f, n*sizeof(Vector2));
+        p = GetBytes(p, enemies.prevPos + f, n*sizeof(Vector2));
+        p = GetBytes(p, enemies.vel + f, n*sizeof(Vector2));
+        p = GetBytes(p, enemies.box + f, n*sizeof(Rectangle));
+        p = GetBytes(p, enemies.dir + f, n*sizeof(int));
+        p = GetBytes(p, enemies.spanMin + f, n*sizeof(float));
+        p = GetBytes(p, enemies.spanMax + f, n*sizeof(float));
+        p = GetBytes(p, enemies.active + f, n*sizeof(bool));
+        p = GetBytes(p, enemies.spawn + f, n*sizeof(int));
+        p = GetBytes(p, enemies.animClip + f, n*sizeof(unsigned char));
+        p = GetBytes(p, enemies.animFrame + f, n*sizeof(int));
+        p = GetBytes(p, enemies.animTimer + f, n*sizeof(float));
+    }
+    p = GetBytes(p, enemies.alive, enemies.aliveCount*sizeof(int));
+    p = GetBytes(p, enemies.awake, enemies.awakeCount*sizeof(int));
+    p = GetBytes(p, enemies.dying, enemies.dyingCount*sizeof(int));
+
+    n = hdr.collectibleCount;
+    ReserveCollectibles(&collectibles, n);
+    collectibles.count = n;
+    collectibles.aliveCount = hdr.collectibleAlive;
+    p = GetBytes(p, collectibles.pos, n*sizeof(Vector2));
+    p = GetBytes(p, collectibles.box, n*sizeof(Rectangle));
+    p = GetBytes(p, collectibles.taken, n*sizeof(bool));
+    p = GetBytes(p, collectibles.spawn, n*sizeof(int));
+    p = GetBytes(p, collectibles.alive, collectibles.aliveCount*sizeof(int));
+
+    n = hdr.shootCount;
+    ReserveShoots(&shoot, n);
+    shoot.count = n;
+    shoot.aliveCount = hdr.shootAlive;
+    shoot.freeCount = hdr.shootFree;
+    p = GetBytes(p, shoot.rec, n*sizeof(Rectangle));
+    p = GetBytes(p, shoot.prevPos, n*sizeof(Vector2));
+    p = GetBytes(p, shoot.speed, n*sizeof(Vector2));
+    p = GetBytes(p, shoot.life, n*sizeof(float));
+    p = GetBytes(p, shoot.owner, n*sizeof(int));
+    p = GetBytes(p, shoot.active, n*sizeof(bool));
+    p = GetBytes(p, shoot.alive, shoot.aliveCount*sizeof(int));
+    p = GetBytes(p, shoot.freeList, shoot.freeCount*sizeof(int));
+
+    p = GetBytes(p, stream.enemyState, level.header->enemyCount);
+    p = GetBytes(p, stream.collectibleState, level.header->collectibleCount);
+
+    for (int k = 0; k < enemies.aliveCount; k++) {
+        int i = enemies.alive[k];
+        SpatialHashInsert(&enemyGrid, i, enemies.box[i]);
+    }
+    for (int k = 0; k < collectibles.aliveCount; k++) {
+        int i = collectibles.alive[k];
+        SpatialHashInsert(&collectibleGrid, i, collectibles.box[i]);
+    }
+    return true;
+}
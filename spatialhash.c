@@ -0,0 +1,272 @@
+// spatialhash.c
+// Fase amplia de colisiones: rejilla uniforme guardada en un hash espacial
+// -----------------------------------
+// Cada elemento (plataforma, enemigo, objeto) se registra en las celdas que
+// toca su caja. Las consultas solo recorren las celdas cercanas al área
+// pedida, así el coste no depende del tamaño total del nivel.
+
+#include "raylib.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define GRID_CELL_SIZE      128.0f  // Lado de una celda en unidades de mundo
+#define GRID_MIN_BUCKETS    1024    // Cubetas iniciales (potencia de 2)
+
+// ----------------------------------------------------------------------
+// ESTRUCTURA DEL HASH ESPACIAL
+// ----------------------------------------------------------------------
+typedef struct SpatialHash {
+    float cellSize;         // Tamaño de celda
+    int bucketCount;        // Número de cubetas (potencia de 2)
+    int *bucketHead;        // Primer nodo de cada cubeta (-1 = vacía)
+
+    // Nodos: un elemento ocupa un nodo por cada celda que toca
+    int *nodeItem;          // Elemento del nodo
+    int *nodeNext;          // Siguiente nodo en la cubeta (o en la lista libre)
+    int nodeCapacity;
+    int nodeCount;          // Nodos en uso
+    int freeNode;           // Primer nodo libre (-1 = ninguno)
+
+    // Datos por elemento
+    int itemCapacity;
+    bool *itemInGrid;       // Está registrado
+    int *itemCells;         // Rango de celdas ocupado: cx0, cy0, cx1, cy1
+    unsigned int *itemStamp;// Marca de la última consulta (evita duplicados)
+    unsigned int stamp;
+
+    // Resultado de la última consulta (crece según haga falta)
+    int *result;
+    int resultCapacity;
+} SpatialHash;
+
+// ----------------------------------------------------------------------
+// Utilidades internas
+// ----------------------------------------------------------------------
+static int HashCell(const SpatialHash *h, int cx, int cy) {
+    unsigned int k = (unsigned int)cx*73856093u ^ (unsigned int)cy*19349663u;
+    return (int)(k & (unsigned int)(h->bucketCount - 1));
+}
+
+static void CellRange(const SpatialHash *h, Rectangle r, int *cells) {
+    cells[0] = (int)floorf(r.x / h->cellSize);
+    cells[1] = (int)floorf(r.y / h->cellSize);
+    cells[2] = (int)floorf((r.x + r.width) / h->cellSize);
+    cells[3] = (int)floorf((r.y + r.height) / h->cellSize);
+}
+
+// realloc que no vuelve sin memoria (como GrowField en entities.c)
+static void *GrowGrid(void *data, int capacity, size_t elemSize) {
+    void *p = realloc(data, (size_t)capacity*elemSize);
+    if (p == NULL) {
+        fprintf(stderr, "spatialhash: sin memoria para %d elementos\n", capacity);
+        exit(1);
+    }
+    return p;
+}
+
+static void EnsureItemCapacity(SpatialHash *h, int item) {
+    if (item < h->itemCapacity) return;
+
+    int cap = (h->itemCapacity > 0) ? h->itemCapacity : 64;
+    while (cap <= item) cap *= 2;
+
+    h->itemInGrid = GrowGrid(h->itemInGrid, cap, sizeof(bool));
+    h->itemCells = GrowGrid(h->itemCells, cap, 4*sizeof(int));
+    h->itemStamp = GrowGrid(h->itemStamp, cap, sizeof(unsigned int));
+
+    for (int i = h->itemCapacity; i < cap; i++) {
+        h->itemInGrid[i] = false;
+        h->itemStamp[i] = 0;
+    }
+    h->itemCapacity = cap;
+}
+
+static int AllocNode(SpatialHash *h) {
+    if (h->freeNode < 0) {
+        int cap = (h->nodeCapacity > 0) ? h->nodeCapacity*2 : 256;
+
+        h->nodeItem = GrowGrid(h->nodeItem, cap, sizeof(int));
+        h->nodeNext = GrowGrid(h->nodeNext, cap, sizeof(int));
+
+        // Encadenar los nodos nuevos en la lista libre
+        for (int i = h->nodeCapacity; i < cap - 1; i++) h->nodeNext[i] = i + 1;
+        h->nodeNext[cap - 1] = -1;
+        h->freeNode = h->nodeCapacity;
+        h->nodeCapacity = cap;
+    }
+
+    int n = h->freeNode;
+    h->freeNode = h->nodeNext[n];
+    h->nodeCount++;
+    return n;
+}
+
+static void LinkItemCells(SpatialHash *h, int item) {
+    const int *c = &h->itemCells[item*4];
+
+    for (int cy = c[1]; cy <= c[3]; cy++) {
+        for (int cx = c[0]; cx <= c[2]; cx++) {
+            int b = HashCell(h, cx, cy);
+            int n = AllocNode(h);
+            h->nodeItem[n] = item;
+            h->nodeNext[n] = h->bucketHead[b];
+            h->bucketHead[b] = n;
+        }
+    }
+}
+
+// Duplica las cubetas cuando hay demasiados nodos por cubeta
+static void GrowBuckets(SpatialHash *h) {
+    h->bucketCount *= 2;
+    h->bucketHead = GrowGrid(h->bucketHead, h->bucketCount, sizeof(int));
+    for (int i = 0; i < h->bucketCount; i++) h->bucketHead[i] = -1;
+
+    // Todos los nodos vuelven a la lista libre y se reinsertan los elementos
+    for (int i = 0; i < h->nodeCapacity - 1; i++) h->nodeNext[i] = i + 1;
+    if (h->nodeCapacity > 0) h->nodeNext[h->nodeCapacity - 1] = -1;
+    h->freeNode = (h->nodeCapacity > 0) ? 0 : -1;
+    h->nodeCount = 0;
+
+    for (int i = 0; i < h->itemCapacity; i++)
+        if (h->itemInGrid[i]) LinkItemCells(h, i);
+}
+
+// ----------------------------------------------------------------------
+// Crear / vaciar / liberar
+// ----------------------------------------------------------------------
+void InitSpatialHash(SpatialHash *h, float cellSize) {
+    *h = (SpatialHash){ 0 };
+    h->cellSize = cellSize;
+    h->bucketCount = GRID_MIN_BUCKETS;
+    h->bucketHead = GrowGrid(NULL, h->bucketCount, sizeof(int));
+    for (int i = 0; i < h->bucketCount; i++) h->bucketHead[i] = -1;
+    h->freeNode = -1;
+}
+
+// Quita todos los elementos (se conserva la memoria reservada)
+void ClearSpatialHash(SpatialHash *h) {
+    for (int i = 0; i < h->bucketCount; i++) h->bucketHead[i] = -1;
+
+    for (int i = 0; i < h->nodeCapacity - 1; i++) h->nodeNext[i] = i + 1;
+    if (h->nodeCapacity > 0) h->nodeNext[h->nodeCapacity - 1] = -1;
+    h->freeNode = (h->nodeCapacity > 0) ? 0 : -1;
+    h->nodeCount = 0;
+
+    for (int i = 0; i < h->itemCapacity; i++) h->itemInGrid[i] = false;
+}
+
+void FreeSpatialHash(SpatialHash *h) {
+    free(h->bucketHead);
+    free(h->nodeItem);
+    free(h->nodeNext);
+    free(h->itemInGrid);
+    free(h->itemCells);
+    free(h->itemStamp);
+    free(h->result);
+    *h = (SpatialHash){ 0 };
+}
+
+// ----------------------------------------------------------------------
+// Insertar / quitar / mover elementos
+// ----------------------------------------------------------------------
+void SpatialHashRemove(SpatialHash *h, int item) {
+    if (item >= h->itemCapacity || !h->itemInGrid[item]) return;
+
+    const int *c = &h->itemCells[item*4];
+
+    for (int cy = c[1]; cy <= c[3]; cy++) {
+        for (int cx = c[0]; cx <= c[2]; cx++) {
+            int *link = &h->bucketHead[HashCell(h, cx, cy)];
+
+            while (*link >= 0) {
+                int n = *link;
+                if (h->nodeItem[n] == item) {
+                    *link = h->nodeNext[n];
+                    h->nodeNext[n] = h->freeNode;
+                    h->freeNode = n;
+                    h->nodeCount--;
+                    break;
+                }
+                link = &h->nodeNext[n];
+            }
+        }
+    }
+
+    h->itemInGrid[item] = false;
+}
+
+void SpatialHashInsert(SpatialHash *h, int item, Rectangle box) {
+    EnsureItemCapacity(h, item);
+    if (h->itemInGrid[item]) SpatialHashRemove(h, item);
+
+    CellRange(h, box, &h->itemCells[item*4]);
+    h->itemInGrid[item] = true;
+    LinkItemCells(h, item);
+
+    if (h->nodeCount > h->bucketCount*2) GrowBuckets(h);
+}
+
+// Actualización incremental: solo toca el hash si cambió de celdas
+void SpatialHashUpdate(SpatialHash *h, int item, Rectangle box) {
+    if (item < h->itemCapacity && h->itemInGrid[item]) {
+        int cells[4];
+        CellRange(h, box, cells);
+
+        const int *c = &h->itemCells[item*4];
+        if (cells[0] == c[0] && cells[1] == c[1] &&
+            cells[2] == c[2] && cells[3] == c[3]) return;
+    }
+
+    SpatialHashInsert(h, item, box);
+}
+
+static int CompareItem(const void *a, const void *b) {
+    int ia = *(const int *)a, ib = *(const int *)b;
+    return (ia > ib) - (ia < ib);
+}
+
+// ----------------------------------------------------------------------
+// Consulta: elementos cuyas celdas tocan el área.
+// Devuelve candidatos sin duplicados y en orden creciente de índice,
+// para que los bucles den el mismo resultado que un recorrido completo.
+// No hay tope: el búfer del hash crece hasta caber todos. El puntero es
+// válido hasta la siguiente consulta sobre el mismo hash.
+// ----------------------------------------------------------------------
+const int *SpatialHashQuery(SpatialHash *h, Rectangle area, int *outCount) {
+    int cells[4];
+    CellRange(h, area, cells);
+
+    h->stamp++;
+    int count = 0;
+
+    for (int cy = cells[1]; cy <= cells[3]; cy++) {
+        for (int cx = cells[0]; cx <= cells[2]; cx++) {
+            for (int n = h->bucketHead[HashCell(h, cx, cy)]; n >= 0; n = h->nodeNext[n]) {
+                int item = h->nodeItem[n];
+                if (h->itemStamp[item] == h->stamp) continue;
+                h->itemStamp[item] = h->stamp;
+
+                if (count == h->resultCapacity) {
+                    h->resultCapacity = (h->resultCapacity > 0) ? h->resultCapacity*2 : 256;
+                    h->result = GrowGrid(h->result, h->resultCapacity, sizeof(int));
+                }
+                h->result[count++] = item;
+            }
+        }
+    }
+
+    // Inserción para las listas cortas (lo normal); qsort si hay muchos
+    int *out = h->result;
+    if (count <= 32) {
+        for (int i = 1; i < count; i++) {
+            int item = out[i], k = i;
+            while (k > 0 && out[k - 1] > item) { out[k] = out[k - 1]; k--; }
+            out[k] = item;
+        }
+    }
+    else qsort(out, count, sizeof(int), CompareItem);
+
+    *outCount = count;
+    return out;
+}
@@ -0,0 +1,241 @@
+// statehash.c
+// Huella (hash) del estado de la partida tras cada tick
+// -----------------------------------
+// Sirve para comprobar que dos ejecuciones siguen la misma línea de tiempo:
+// una repetición guarda las huellas al grabarse y avisa del primer tramo
+// que no coincide al reproducirse; headless puede escribir la traza de una
+// versión de referencia y comparar otra con ella (cambios de rendimiento
+// que no deben cambiar el comportamiento).
+//
+// El estado de las entidades entra por las sumas que mantiene gameplay.c
+// al escribirlas (statemix.c): enemigos vivos (posición, dirección, tramo
+// caminable), muertes visibles, objetos sin recoger, disparos vivos y el
+// estado de cada posición inicial del nivel. Cada tick solo se pasan por
+// el hash esas sumas, los jugadores, las banderas y los contadores: el
+// coste no depende de cuántas entidades haya.
+//
+// Algoritmo según la compilación (STATE_HASH_ALGO, ver statemix.c):
+//   por defecto             xxHash32
+//   GAME_STATE_HASH_CRC32   CRC32 (IEEE, tabla de 256)
+//   GAME_NO_STATE_HASH      sin huella (HashGameState devuelve 0)
+//
+// Se incluye después de gameplay.c.
+
+#include <stdint.h>
+#include <string.h>
+
+#if STATE_HASH_ALGO != 0
+
+// ------------------------------
+// xxHash32 incremental (se alimenta por trozos de cualquier tamaño)
+// ------------------------------
+#define XXH_PRIME1 0x9E3779B1u
+#define XXH_PRIME2 0x85EBCA77u
+#define XXH_PRIME3 0xC2B2AE3Du
+#define XXH_PRIME4 0x27D4EB2Fu
+#define XXH_PRIME5 0x165667B1u
+
+typedef struct StateHasher {
+    uint32_t v[4];                  // Acumuladores de xxHash32 (o v[0] = CRC)
+    uint32_t seed;
+    uint32_t total;                 // Bytes recibidos
+    unsigned char buffer[16];       // Resto sin procesar (< 16 bytes)
+    int buffered;
+} StateHasher;
+
+static uint32_t ReadLE32(const unsigned char *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+#if STATE_HASH_ALGO == 1
+static uint32_t RotL32(uint32_t x, int r) { return (x << r) | (x >> (32 - r)); }
+
+static uint32_t XxhRound(uint32_t acc, uint32_t input) {
+    acc += input*XXH_PRIME2;
+    return RotL32(acc, 13)*XXH_PRIME1;
+}
+
+static void XxhStripe(StateHasher *h, const unsigned char *p) {
+    h->v[0] = XxhRound(h->v[0], ReadLE32(p));
+    h->v[1] = XxhRound(h->v[1], ReadLE32(p + 4));
+    h->v[2] = XxhRound(h->v[2], ReadLE32(p + 8));
+    h->v[3] = XxhRound(h->v[3], ReadLE32(p + 12));
+}
+#endif
+
+// ------------------------------
+// CRC32 (polinomio reflejado 0xEDB88320, el de zlib). Se procesan 4 bytes
+// por paso con 4 tablas (slice-by-4).
+// ------------------------------
+#if STATE_HASH_ALGO == 2
+static uint32_t crcTable[4][256];
+static bool crcTableReady = false;
+
+static void BuildCrcTable(void) {
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        crcTable[0][i] = c;
+    }
+    for (int t = 1; t < 4; t++)
+        for (int i = 0; i < 256; i++)
+            crcTable[t][i] = crcTable[0][crcTable[t - 1][i] & 0xff] ^ (crcTable[t - 1][i] >> 8);
+    crcTableReady = true;
+}
+#endif
+
+static void HasherReset(StateHasher *h, uint32_t seed) {
+    h->seed = seed;
+    h->total = 0;
+    h->buffered = 0;
+#if STATE_HASH_ALGO == 2
+    if (!crcTableReady) BuildCrcTable();
+    h->v[0] = ~seed;
+#else
+    h->v[0] = seed + XXH_PRIME1 + XXH_PRIME2;
+    h->v[1] = seed + XXH_PRIME2;
+    h->v[2] = seed;
+    h->v[3] = seed - XXH_PRIME1;
+#endif
+}
+
+static void HasherUpdate(StateHasher *h, const void *data, size_t size) {
+    const unsigned char *p = data;
+    h->total += (uint32_t)size;
+
+#if STATE_HASH_ALGO == 2
+    uint32_t c = h->v[0];
+    for (; size >= 4; p += 4, size -= 4) {
+        c ^= ReadLE32(p);
+        c = crcTable[3][c & 0xff] ^ crcTable[2][(c >> 8) & 0xff] ^
+            crcTable[1][(c >> 16) & 0xff] ^ crcTable[0][c >> 24];
+    }
+    for (; size > 0; p++, size--) c = crcTable[0][(c ^ *p) & 0xff] ^ (c >> 8);
+    h->v[0] = c;
+#else
+    // Completar el resto pendiente
+    if (h->buffered > 0) {
+        size_t take = 16 - h->buffered;
+        if (take > size) take = size;
+        memcpy(h->buffer + h->buffered, p, take);
+        h->buffered += (int)take;
+        p += take;
+        size -= take;
+        if (h->buffered < 16) return;
+        XxhStripe(h, h->buffer);
+        h->buffered = 0;
+    }
+
+    for (; size >= 16; p += 16, size -= 16) XxhStripe(h, p);
+
+    memcpy(h->buffer, p, size);
+    h->buffered = (int)size;
+#endif
+}
+
+static uint32_t HasherDigest(const StateHasher *h) {
+#if STATE_HASH_ALGO == 2
+    return ~h->v[0];
+#else
+    uint32_t acc;
+    if (h->total >= 16) acc = RotL32(h->v[0], 1) + RotL32(h->v[1], 7) + RotL32(h->v[2], 12) + RotL32(h->v[3], 18);
+    else acc = h->seed + XXH_PRIME5;
+    acc += h->total;
+
+    const unsigned char *p = h->buffer;
+    int left = h->buffered;
+    for (; left >= 4; p += 4, left -= 4) acc = RotL32(acc + ReadLE32(p)*XXH_PRIME3, 17)*XXH_PRIME4;
+    for (; left > 0; p++, left--) acc = RotL32(acc + (*p)*XXH_PRIME5, 11)*XXH_PRIME1;
+
+    acc ^= acc >> 15;
+    acc *= XXH_PRIME2;
+    acc ^= acc >> 13;
+    acc *= XXH_PRIME3;
+    acc ^= acc >> 16;
+    return acc;
+#endif
+}
+
+#endif
+
+// ------------------------------
+// Huella del estado actual. Los campos se copian como palabras de 32 bits
+// (nunca structs enteros: el relleno entre campos no está inicializado) y
+// se combinan como las entidades de statemix.c, con una clave por posición
+// (multiplicaciones independientes, no una cadena de rondas del hash). El
+// algoritmo de la compilación solo digiere el resultado.
+// ------------------------------
+#define STATE_HASH_WORDS (1 + 6*MAX_PLAYERS + 10 + (int)(sizeof(StateMix)/sizeof(uint32_t)))
+
+#if STATE_HASH_ALGO != 0
+#define MIX_SALT_STATE 0x082EFA98u
+
+static uint32_t stateKeys[STATE_HASH_WORDS];
+static bool stateKeysReady = false;
+#endif
+
+uint32_t HashGameState(void) {
+#if STATE_HASH_ALGO == 0
+    return 0;
+#else
+    if (!stateKeysReady) {
+        for (int k = 0; k < STATE_HASH_WORDS; k++) stateKeys[k] = MixKey((uint32_t)k, MIX_SALT_STATE);
+        stateKeysReady = true;
+    }
+
+    const uint32_t *key = stateKeys;
+    uint32_t fold = 0;
+    #define FOLD(word) (fold += (uint32_t)(word)*(*key++))
+
+    FOLD((uint32_t)gameOver | (uint32_t)victory << 1 | (uint32_t)pauseGame << 2 | (uint32_t)playerCount << 8);
+
+    for (int p = 0; p < playerCount; p++) {
+        const Player *pl = &players[p];
+        FOLD(MixBits(pl->pos.x));
+        FOLD(MixBits(pl->pos.y));
+        FOLD(MixBits(pl->vel.x));
+        FOLD(MixBits(pl->vel.y));
+        FOLD((uint32_t)pl->lives | (uint32_t)pl->onGround << 16 | (uint32_t)pl->anim.state << 24);
+        FOLD(pl->score);
+    }
+    key = stateKeys + 1 + 6*MAX_PLAYERS;    // Mismas claves con 1 o 2 jugadores
+
+    FOLD(enemies.count);
+    FOLD(enemies.aliveCount);
+    FOLD(enemies.awakeCount);
+    FOLD(enemies.dyingCount);
+    FOLD(collectibles.aliveCount);
+    FOLD(shoot.aliveCount);
+    FOLD(shootRate);
+    FOLD(stream.first);
+    FOLD(stream.last);
+    FOLD(activationCell);
+
+    FOLD(stateMix.enemies);
+    FOLD(stateMix.dying);
+    FOLD(stateMix.collectibles);
+    FOLD(stateMix.shoots);
+    FOLD(stateMix.enemySpawns);
+    FOLD(stateMix.collectibleSpawns);
+    #undef FOLD
+
+    StateHasher h;
+    HasherReset(&h, 0);
+    HasherUpdate(&h, &fold, sizeof(fold));
+    return HasherDigest(&h);
+#endif
+}
+
+// Encadena la huella de un tick a la de todos los anteriores: basta
+// comparar el último valor para saber si dos trazas coinciden
+uint32_t ChainStateHash(uint32_t chain, uint32_t tickHash) {
+#if STATE_HASH_ALGO == 0
+    (void)tickHash;
+    return chain;
+#else
+    StateHasher h;
+    HasherReset(&h, chain);
+    HasherUpdate(&h, &tickHash, sizeof(tickHash));
+    return HasherDigest(&h);
+#endif
+}
@@ -0,0 +1,83 @@
+// statemix.c
+// Parte incremental de la huella del estado (ver statehash.c)
+// -----------------------------------
+// Recorrer cada tick todos los enemigos despiertos y disparos vivos para
+// la huella cuesta tanto como moverlos. En su lugar cada almacén lleva una
+// suma de lo que aporta cada entidad viva, y se corrige donde se escribe
+// la entidad: al aparecer se suma, al morir se resta y al moverse se suma
+// la diferencia. HashGameState solo pasa por el hash esas sumas, los
+// jugadores y los contadores.
+//
+// Lo que aporta una entidad es la clave de su hueco por una combinación
+// lineal de sus campos (como palabras de 32 bits):
+//     clave(hueco) * (campo1*MIX_W1 + campo2*MIX_W2 + ...)
+// Al ser lineal, un cambio en unos pocos campos se corrige con la
+// diferencia de esos campos, sin leer el resto; al sumar, el orden da
+// igual (los trabajos de UpdateEnemies suman cada uno su parte). La clave
+// es pseudoaleatoria (impar) por hueco, así que dos entidades desviadas no
+// se compensan por casualidad salvo con probabilidad ~2^-32.
+//
+// Con GAME_NO_STATE_HASH no se mantiene nada (STATE_HASH_ALGO 0).
+
+#include <stdint.h>
+#include <string.h>
+
+// Algoritmo de la huella según la compilación
+#if defined(GAME_NO_STATE_HASH)
+    #define STATE_HASH_ALGO 0
+    #define STATE_HASH_NAME "ninguno"
+#elif defined(GAME_STATE_HASH_CRC32)
+    #define STATE_HASH_ALGO 2
+    #define STATE_HASH_NAME "crc32"
+#else
+    #define STATE_HASH_ALGO 1
+    #define STATE_HASH_NAME "xxh32"
+#endif
+
+// Sumas de cada conjunto (aritmética módulo 2^32)
+typedef struct StateMix {
+    uint32_t enemies;           // Enemigos vivos: posición, dirección, tramo, posición inicial
+    uint32_t dying;             // Huecos en la lista de muertes visibles
+    uint32_t collectibles;      // Objetos sin recoger: posición, posición inicial
+    uint32_t shoots;            // Disparos vivos: posición, vida, jugador
+    uint32_t enemySpawns;       // SPAWN_* de cada enemigo del nivel
+    uint32_t collectibleSpawns; // SPAWN_* de cada objeto del nivel
+} StateMix;
+
+// Sal de la clave de cada conjunto (huecos distintos, claves distintas)
+#define MIX_SALT_ENEMY            0x243F6A88u
+#define MIX_SALT_DYING            0x85A308D3u
+#define MIX_SALT_COLLECTIBLE      0x13198A2Eu
+#define MIX_SALT_SHOOT            0x03707344u
+#define MIX_SALT_ENEMY_SPAWN      0xA4093822u
+#define MIX_SALT_COLLECTIBLE_SPAWN 0x299F31D0u
+
+// Pesos de cada campo en la combinación (impares)
+#define MIX_W_X      0x9E3779B1u
+#define MIX_W_Y      0x85EBCA77u
+#define MIX_W_DIR    0xC2B2AE3Du
+#define MIX_W_MIN    0x27D4EB2Fu
+#define MIX_W_MAX    0x165667B1u
+#define MIX_W_SPAWN  0xD3A2646Du
+#define MIX_W_LIFE   0xFD7046C5u
+#define MIX_W_OWNER  0xB55A4F09u
+
+#if STATE_HASH_ALGO != 0
+// Clave de un hueco: finalizador de MurmurHash3, forzada a impar (multiplicar
+// por ella no pierde ningún bit de la diferencia)
+static uint32_t MixKey(uint32_t slot, uint32_t salt) {
+    uint32_t k = slot ^ salt;
+    k ^= k >> 16;
+    k *= 0x85EBCA6Bu;
+    k ^= k >> 13;
+    k *= 0xC2B2AE35u;
+    k ^= k >> 16;
+    return k | 1u;
+}
+
+static uint32_t MixBits(float f) {
+    uint32_t w;
+    memcpy(&w, &f, sizeof(w));
+    return w;
+}
+#endif
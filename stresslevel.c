@@ -0,0 +1,111 @@
+// stresslevel.c
+// Niveles de prueba generados a partir de una semilla
+// -----------------------------------
+// Llena un nivel con N plataformas, N enemigos y N objetos para medir cómo
+// escala cada subsistema (ver bench.c). La misma semilla da siempre el
+// mismo nivel. El resultado es una imagen de BuildLevelImage, así que se
+// puede usar directamente (UseGeneratedLevel) o guardar como .lvl
+// (levelconv --stress).
+//
+// Distribución:
+//   - suelos de tipo 4 a lo largo de todo el nivel, con huecos saltables
+//   - plataformas flotantes por encima de la cabeza del jugador en el suelo
+//   - cada enemigo sobre una plataforma o suelo elegido al azar, con los
+//     arquetipos (enemy_types.c) mezclados por turnos
+//   - objetos repartidos en X a alturas alcanzables
+
+#include "raylib.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+
+#define STRESS_SPACING      32.0f       // Ancho de nivel por entidad (si no se fija el ancho)
+#define STRESS_GROUND_Y     420.0f
+#define STRESS_GROUND_WIDTH 1024.0f
+#define STRESS_START_X      200.0f      // Zona libre alrededor de la posición inicial
+#define STRESS_ENEMY_TYPES  4           // Arquetipos que se mezclan (ENEMY_TYPES)
+
+// xorshift32: rápido y reproducible en cualquier plataforma
+static uint32_t StressRand(uint32_t *state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+// Número en [lo, hi)
+static float StressRange(uint32_t *state, float lo, float hi) {
+    return lo + (hi - lo)*(float)(StressRand(state) >> 8)/16777216.0f;
+}
+
+// ----------------------------------------------------------------------
+// Genera el nivel. width <= 0 usa count*STRESS_SPACING (densidad fija: la
+// parte cargada no crece con N); un ancho fijo hace el nivel más denso.
+// Devuelve la imagen (malloc) y su tamaño, o NULL si no hay memoria.
+// ----------------------------------------------------------------------
+void *GenerateStressLevel(uint32_t seed, int count, float width, size_t *outSize) {
+
+    if (count < 1) count = 1;
+    if (width <= 0) width = count*STRESS_SPACING;
+    if (width < 2*STRESS_GROUND_WIDTH) width = 2*STRESS_GROUND_WIDTH;
+
+    uint32_t state = seed ? seed : 0x9e3779b9u;     // xorshift no admite 0
+
+    // Suelos: tantos como quepan, nunca más que el total de plataformas
+    int groundCount = (int)(width/STRESS_GROUND_WIDTH);
+    if (groundCount > count) groundCount = count;
+
+    Rectangle *box = malloc(count*sizeof(Rectangle));
+    int32_t *type = malloc(count*sizeof(int32_t));
+    Vector2 *enemy = malloc(count*sizeof(Vector2));
+    unsigned char *enemyType = malloc(count);
+    Vector2 *item = malloc(count*sizeof(Vector2));
+
+    if (box == NULL || type == NULL || enemy == NULL || enemyType == NULL || item == NULL) {
+        free(box); free(type); free(enemy); free(enemyType); free(item);
+        return NULL;
+    }
+
+    // El primer suelo empieza bajo la posición inicial y no tiene hueco delante
+    float step = width/groundCount;
+    for (int i = 0; i < groundCount; i++) {
+        float gap = (i == 0) ? 0 : StressRange(&state, 0, 160);
+        box[i] = (Rectangle){ 10 + i*step + gap, STRESS_GROUND_Y, step - gap, 1600 };
+        type[i] = 4;
+    }
+
+    // Flotantes: la parte inferior queda por encima del jugador de pie en el suelo
+    for (int i = groundCount; i < count; i++) {
+        float w = StressRange(&state, 64, 240);
+        float y = 16*floorf(StressRange(&state, 120, 330)/16);   // alturas en rejilla, como un nivel hecho a mano
+        box[i] = (Rectangle){ StressRange(&state, STRESS_START_X, width - w), y, w, 24 };
+        type[i] = (int32_t)(StressRand(&state) % 10);
+        if (type[i] >= 4) type[i]++;                // 0..10 sin el 4 (suelo)
+    }
+
+    // Enemigos sobre una superficie al azar, lejos de la posición inicial
+    for (int i = 0; i < count; i++) {
+        Rectangle b;
+        float x;
+        do {
+            b = box[StressRand(&state) % count];
+            x = StressRange(&state, b.x, b.x + b.width);
+        } while (x < STRESS_START_X*2);
+        enemy[i] = (Vector2){ x, b.y };
+        enemyType[i] = (unsigned char)(i % STRESS_ENEMY_TYPES);
+    }
+
+    for (int i = 0; i < count; i++)
+        item[i] = (Vector2){ StressRange(&state, STRESS_START_X, width), StressRange(&state, 150, 380) };
+
+    void *image = BuildLevelImage((Vector2){ 120, 300 }, width, LEVEL_CHUNK_WIDTH,
+                                  box, type, count, enemy, enemyType, count, item, count, NULL, outSize);
+
+    free(box);
+    free(type);
+    free(enemy);
+    free(enemyType);
+    free(item);
+    return image;
+}
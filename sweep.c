@@ -0,0 +1,88 @@
+// sweep.c
+// Pruebas de colisión por barrido (continuas)
+// -----------------------------------
+// Un objeto rápido puede atravesar una caja entre dos ticks si solo se
+// comprueba su posición final. Aquí se prueba el recorrido completo del
+// tick y se devuelve el instante del primer contacto (0..1).
+
+#include "raylib.h"
+#include <math.h>
+
+// ----------------------------------------------------------------------
+// Segmento from -> from + delta contra una caja (método de las franjas).
+// Devuelve true si el segmento entra en la caja y guarda en *tHit la
+// fracción del recorrido en la que la toca (0 si ya empieza dentro).
+// ----------------------------------------------------------------------
+bool SweepSegmentRec(Vector2 from, Vector2 delta, Rectangle box, float *tHit) {
+    float tMin = 0.0f, tMax = 1.0f;
+
+    const float origin[2] = { from.x, from.y };
+    const float dir[2] = { delta.x, delta.y };
+    const float lo[2] = { box.x, box.y };
+    const float hi[2] = { box.x + box.width, box.y + box.height };
+
+    for (int a = 0; a < 2; a++) {
+        if (dir[a] == 0.0f) {
+            // Paralelo a esta franja: tiene que estar ya dentro de ella
+            if (origin[a] < lo[a] || origin[a] > hi[a]) return false;
+            continue;
+        }
+
+        float t0 = (lo[a] - origin[a]) / dir[a];
+        float t1 = (hi[a] - origin[a]) / dir[a];
+        if (t0 > t1) { float tmp = t0; t0 = t1; t1 = tmp; }
+
+        if (t0 > tMin) tMin = t0;
+        if (t1 < tMax) tMax = t1;
+        if (tMin > tMax) return false;
+    }
+
+    *tHit = tMin;
+    return true;
+}
+
+// ----------------------------------------------------------------------
+// Caja móvil contra caja fija: equivale a barrer la esquina de la caja
+// móvil contra la caja fija agrandada con su tamaño (suma de Minkowski).
+// ----------------------------------------------------------------------
+bool SweepRecRec(Rectangle moving, Vector2 delta, Rectangle box, float *tHit) {
+    Rectangle grown = { box.x - moving.width, box.y - moving.height,
+                        box.width + moving.width, box.height + moving.height };
+    return SweepSegmentRec((Vector2){ moving.x, moving.y }, delta, grown, tHit);
+}
+
+// Caja que cubre todo el recorrido (para consultar la fase amplia)
+Rectangle SweptBounds(Rectangle moving, Vector2 delta) {
+    return (Rectangle){
+        fminf(moving.x, moving.x + delta.x), fminf(moving.y, moving.y + delta.y),
+        moving.width + fabsf(delta.x), moving.height + fabsf(delta.y)
+    };
+}
+
+// ----------------------------------------------------------------------
+// Barrido sobre un solo eje (axis 0 = X, 1 = Y) para resolver por ejes.
+// Devuelve la fracción de delta que se puede recorrer antes de tocar la
+// caja (1 = libre). Solo cuentan las cajas que se solapan de verdad en el
+// otro eje (apoyarse en un borde no es chocar con él) y que están delante:
+// si la caja móvil ya está dentro, no la bloquea.
+// ----------------------------------------------------------------------
+#define SWEEP_EPSILON 0.01f
+
+float SweepRecAxis(Rectangle moving, float delta, int axis, Rectangle box) {
+    float mPos  = axis ? moving.y : moving.x,      mSize  = axis ? moving.height : moving.width;
+    float bPos  = axis ? box.y : box.x,            bSize  = axis ? box.height : box.width;
+    float mSide = axis ? moving.x : moving.y,      mSideSize = axis ? moving.width : moving.height;
+    float bSide = axis ? box.x : box.y,            bSideSize = axis ? box.width : box.height;
+
+    if (delta == 0.0f) return 1.0f;
+    if (mSide >= bSide + bSideSize || mSide + mSideSize <= bSide) return 1.0f;
+
+    // Distancia desde la cara delantera de la caja móvil hasta la caja
+    float gap = (delta > 0) ? bPos - (mPos + mSize) : (bPos + bSize) - mPos;
+
+    if (delta > 0 ? gap < -SWEEP_EPSILON : gap > SWEEP_EPSILON) return 1.0f;   // ya dentro o detrás
+
+    float t = gap / delta;
+    if (t < 0.0f) t = 0.0f;
+    return (t < 1.0f) ? t : 1.0f;
+}
@@ -0,0 +1,231 @@
+// tilemap.c
+// Mundo en rejilla de casillas: solidez en un mapa de bits
+// -----------------------------------
+// Alternativa a la lista de plataformas para niveles grandes hechos a mano.
+// Cada casilla guarda su tipo en un byte (0 = vacía, t + 1 = textura de
+// plataforma t), en el sitio dentro del nivel mapeado, y su solidez en un
+// bit aparte: 64 casillas de una fila por palabra. Preguntar si hay suelo,
+// pared o borde es leer un bit, y una fila entera bajo unos pies se mira con
+// una o dos máscaras, sin recorrer plataformas.
+//
+// Los barridos y los rayos avanzan casilla a casilla (DDA): solo visitan las
+// líneas de la rejilla que cruzan, así que el coste depende de la distancia
+// recorrida y no del tamaño del nivel. Fuera del mapa todo está vacío
+// (como el vacío bajo un nivel de plataformas).
+
+#include "raylib.h"
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+typedef struct TileMap {
+    int cols, rows;
+    float tileSize;
+    Vector2 origin;                 // Esquina superior izquierda de la casilla (0, 0)
+    const unsigned char *type;      // cols*rows, por filas (del nivel, no se libera)
+    uint64_t *solid;                // Bits por filas, rowWords palabras por fila (en la arena del nivel)
+    int rowWords;
+} TileMap;
+
+// ----------------------------------------------------------------------
+// Crear / liberar
+// ----------------------------------------------------------------------
+
+// Usa el array de tipos en el sitio y construye el mapa de bits en la arena.
+// cols o rows a 0: sin casillas (todas las consultas dan vacío).
+void UseTileMap(TileMap *tm, Arena *arena, int cols, int rows, float tileSize, Vector2 origin, const unsigned char *type) {
+    *tm = (TileMap){ 0 };
+    if (cols <= 0 || rows <= 0 || tileSize <= 0 || type == NULL) return;
+
+    int rowWords = (cols + 63)/64;
+    size_t bytes = (size_t)rowWords*rows*sizeof(uint64_t);
+    uint64_t *solid = ArenaAlloc(arena, bytes);
+    memset(solid, 0, bytes);
+
+    for (int y = 0; y < rows; y++) {
+        const unsigned char *row = type + (size_t)y*cols;
+        uint64_t *bits = solid + (size_t)y*rowWords;
+        for (int x = 0; x < cols; x++)
+            if (row[x] != 0) bits[x >> 6] |= 1ull << (x & 63);
+    }
+
+    *tm = (TileMap){ cols, rows, tileSize, origin, type, solid, rowWords };
+}
+
+// ----------------------------------------------------------------------
+// Consultas O(1)
+// ----------------------------------------------------------------------
+bool IsTileSolid(const TileMap *tm, int x, int y) {
+    if ((unsigned)x >= (unsigned)tm->cols || (unsigned)y >= (unsigned)tm->rows) return false;
+    return (tm->solid[(size_t)y*tm->rowWords + (x >> 6)] >> (x & 63)) & 1;
+}
+
+int GetTileType(const TileMap *tm, int x, int y) {
+    if ((unsigned)x >= (unsigned)tm->cols || (unsigned)y >= (unsigned)tm->rows) return 0;
+    return tm->type[(size_t)y*tm->cols + x];
+}
+
+// Casilla que contiene la coordenada de mundo (sin recortar al mapa)
+int TileColumnOf(const TileMap *tm, float x) { return (int)floorf((x - tm->origin.x)/tm->tileSize); }
+int TileRowOf(const TileMap *tm, float y) { return (int)floorf((y - tm->origin.y)/tm->tileSize); }
+
+// ¿Alguna casilla sólida en la fila y entre las columnas x0..x1? (máscaras por palabra)
+bool TileRowAnySolid(const TileMap *tm, int y, int x0, int x1) {
+    if ((unsigned)y >= (unsigned)tm->rows) return false;
+    if (x0 < 0) x0 = 0;
+    if (x1 >= tm->cols) x1 = tm->cols - 1;
+    if (x0 > x1) return false;
+
+    const uint64_t *bits = tm->solid + (size_t)y*tm->rowWords;
+    int w0 = x0 >> 6, w1 = x1 >> 6;
+    uint64_t first = ~0ull << (x0 & 63);
+    uint64_t last = ~0ull >> (63 - (x1 & 63));
+
+    if (w0 == w1) return (bits[w0] & first & last) != 0;
+    if (bits[w0] & first) return true;
+    for (int w = w0 + 1; w < w1; w++) if (bits[w]) return true;
+    return (bits[w1] & last) != 0;
+}
+
+// ¿Alguna casilla sólida en la columna x entre las filas y0..y1?
+bool TileColumnAnySolid(const TileMap *tm, int x, int y0, int y1) {
+    if ((unsigned)x >= (unsigned)tm->cols) return false;
+    if (y0 < 0) y0 = 0;
+    if (y1 >= tm->rows) y1 = tm->rows - 1;
+
+    const uint64_t *bits = tm->solid + (size_t)y0*tm->rowWords + (x >> 6);
+    uint64_t mask = 1ull << (x & 63);
+    for (int y = y0; y <= y1; y++, bits += tm->rowWords)
+        if (*bits & mask) return true;
+    return false;
+}
+
+// ----------------------------------------------------------------------
+// Barrido de una caja sobre un eje (axis 0 = X, 1 = Y), con las mismas
+// reglas que SweepRecAxis (sweep.c): solo bloquean las casillas que
+// solapan de verdad en el otro eje y que están delante de la cara que
+// avanza. Recorre las líneas de la rejilla que cruza esa cara (DDA en un
+// eje) y en cada una mira el tramo de casillas que ocupa la caja.
+// Devuelve la fracción de delta recorrible (1 = libre) y en *face la
+// coordenada de la cara de casilla que la detiene.
+// ----------------------------------------------------------------------
+#define TILE_SWEEP_EPSILON 0.01f
+
+float SweepTilesAxis(const TileMap *tm, Rectangle moving, float delta, int axis, float *face) {
+    if (delta == 0.0f || tm->cols == 0) return 1.0f;
+
+    float ts = tm->tileSize;
+    float o = axis ? tm->origin.y : tm->origin.x;
+    float oSide = axis ? tm->origin.x : tm->origin.y;
+    float mPos = axis ? moving.y : moving.x,   mSize = axis ? moving.height : moving.width;
+    float mSide = axis ? moving.x : moving.y,  mSideSize = axis ? moving.width : moving.height;
+    int lines = axis ? tm->rows : tm->cols;
+
+    // Casillas del otro eje que la caja solapa (tocar un borde no cuenta)
+    int s0 = (int)floorf((mSide - oSide)/ts);
+    int s1 = (int)ceilf((mSide + mSideSize - oSide)/ts) - 1;
+
+    float front = (delta > 0) ? mPos + mSize : mPos;
+    int step = (delta > 0) ? 1 : -1;
+
+    // Primera línea delante de la cara (o que la cara apenas pisa)
+    int k = (delta > 0) ? (int)ceilf((front - TILE_SWEEP_EPSILON - o)/ts)
+                        : (int)floorf((front + TILE_SWEEP_EPSILON - o)/ts) - 1;
+
+    // Fuera del mapa no hay nada: saltar hasta su borde
+    if (k < 0) { if (step < 0) return 1.0f; k = 0; }
+    if (k >= lines) { if (step > 0) return 1.0f; k = lines - 1; }
+
+    for (; k >= 0 && k < lines; k += step) {
+        float edge = o + (step > 0 ? k : k + 1)*ts;     // Cara de la casilla hacia la caja
+        float gap = edge - front;
+        if (step > 0 ? gap >= delta : gap <= delta) break;
+
+        bool blocked = axis ? TileRowAnySolid(tm, k, s0, s1) : TileColumnAnySolid(tm, k, s0, s1);
+        if (blocked) {
+            float t = gap/delta;
+            *face = edge;
+            return (t > 0.0f) ? t : 0.0f;
+        }
+    }
+    return 1.0f;
+}
+
+// ----------------------------------------------------------------------
+// Rayo from -> from + delta (DDA de Amanatides-Woo): recorre en orden las
+// casillas que cruza el segmento. Devuelve true si entra en una sólida y
+// guarda en *tHit la fracción del recorrido (0 si empieza dentro).
+// ----------------------------------------------------------------------
+bool RaycastTiles(const TileMap *tm, Vector2 from, Vector2 delta, float *tHit) {
+    if (tm->cols == 0) return false;
+
+    float ts = tm->tileSize;
+    float fx = (from.x - tm->origin.x)/ts, fy = (from.y - tm->origin.y)/ts;
+    float dx = delta.x/ts, dy = delta.y/ts;
+
+    int x = (int)floorf(fx), y = (int)floorf(fy);
+    int endX = (int)floorf(fx + dx), endY = (int)floorf(fy + dy);
+    int stepX = (dx > 0) ? 1 : -1, stepY = (dy > 0) ? 1 : -1;
+
+    // Fracción del recorrido para cruzar una casilla en cada eje y hasta la primera línea
+    float tDeltaX = (dx != 0) ? fabsf(1.0f/dx) : INFINITY;
+    float tDeltaY = (dy != 0) ? fabsf(1.0f/dy) : INFINITY;
+    float tMaxX = (dx != 0) ? ((dx > 0) ? (x + 1 - fx) : (fx - x))*tDeltaX : INFINITY;
+    float tMaxY = (dy != 0) ? ((dy > 0) ? (y + 1 - fy) : (fy - y))*tDeltaY : INFINITY;
+
+    float t = 0.0f;
+    for (;;) {
+        if (IsTileSolid(tm, x, y)) {
+            *tHit = t;
+            return true;
+        }
+        if (x == endX && y == endY) return false;
+
+        if (tMaxX < tMaxY) {
+            t = tMaxX;
+            tMaxX += tDeltaX;
+            x += stepX;
+        } else {
+            t = tMaxY;
+            tMaxY += tDeltaY;
+            y += stepY;
+        }
+        if (t > 1.0f) return false;
+    }
+}
+
+// ----------------------------------------------------------------------
+// Tramo caminable sobre casillas (mismo uso que BuildWalkSpans en patrol.c).
+// Busca la superficie bajo (x, y) dentro de la tolerancia de patrol.c y
+// la sigue a los lados mientras haya suelo debajo y no haya pared a la
+// altura del cuerpo. false si no apoya en ninguna casilla.
+// ----------------------------------------------------------------------
+bool TileWalkSpan(const TileMap *tm, Vector2 pos, float halfWidth, float height, WalkSpan *out) {
+    if (tm->cols == 0) return false;
+
+    int x = TileColumnOf(tm, pos.x);
+    int yTop = TileRowOf(tm, pos.y - PATROL_SNAP_ABOVE);
+    int yBottom = TileRowOf(tm, pos.y + PATROL_SNAP_BELOW);
+
+    // Primera casilla sólida con una vacía encima (la superficie)
+    int ground = -1;
+    for (int y = yTop; y <= yBottom && ground < 0; y++)
+        if (IsTileSolid(tm, x, y) && !IsTileSolid(tm, x, y - 1)) ground = y;
+    if (ground < 0) return false;
+
+    // Filas que ocupa el cuerpo sobre la superficie
+    int bodyRows = (int)ceilf(height/tm->tileSize);
+    int body0 = ground - bodyRows, body1 = ground - 1;
+
+    int x0 = x, x1 = x;
+    while (IsTileSolid(tm, x0 - 1, ground) && !TileColumnAnySolid(tm, x0 - 1, body0, body1)) x0--;
+    while (IsTileSolid(tm, x1 + 1, ground) && !TileColumnAnySolid(tm, x1 + 1, body0, body1)) x1++;
+
+    float left = tm->origin.x + x0*tm->tileSize;
+    float right = tm->origin.x + (x1 + 1)*tm->tileSize;
+    *out = (WalkSpan){ left + halfWidth, right - halfWidth, tm->origin.y + ground*tm->tileSize };
+
+    // Superficie más estrecha que el enemigo: se queda en el centro
+    if (out->minX > out->maxX) out->minX = out->maxX = (left + right)/2;
+    return true;
+}